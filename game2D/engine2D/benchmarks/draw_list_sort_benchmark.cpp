@@ -0,0 +1,111 @@
+#include <render/draw_list.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Microbenchmark of the draw list radix sort against std::stable_sort on the
+// same keys
+
+namespace
+{
+constexpr int repeats{50};
+
+using entries = std::vector<render::draw_list::entry>;
+
+// a frame of sprites spread over a few layers, programs and textures
+entries make_frame(size_t count)
+{
+  std::mt19937 random{42};
+  std::uniform_int_distribution<int> layer{0, 7};
+  std::uniform_int_distribution<unsigned int> program{1, 4};
+  std::uniform_int_distribution<unsigned int> texture{1, 32};
+  std::uniform_int_distribution<int> blend{0, 2};
+
+  entries result{};
+  for (size_t it{0}; it < count; it++)
+    result.push_back(
+        {render::draw_list::make_key(
+             layer(random), static_cast<render::blend_mode>(blend(random)),
+             0.f, program(random), texture(random), it),
+         static_cast<std::uint32_t>(it), render::draw_list::item_type::sprite});
+  return result;
+}
+
+// every key field differs, the worst case for the radix sort
+entries make_random(size_t count)
+{
+  std::mt19937 random{42};
+  std::uniform_int_distribution<int> layer{-128, 127};
+  std::uniform_real_distribution<float> depth{0.f, 1.f};
+  std::uniform_int_distribution<unsigned int> id{0, 0xffff};
+  std::uniform_int_distribution<int> blend{0, 2};
+
+  entries result{};
+  for (size_t it{0}; it < count; it++)
+    result.push_back(
+        {render::draw_list::make_key(
+             layer(random), static_cast<render::blend_mode>(blend(random)),
+             depth(random), id(random), id(random), it),
+         static_cast<std::uint32_t>(it), render::draw_list::item_type::sprite});
+  return result;
+}
+
+template <typename sorter>
+double measure(sorter function, const entries& input, entries& output)
+{
+  double best{1e30};
+  for (int repeat{0}; repeat < repeats; repeat++)
+    {
+      output = input;
+      const auto start{std::chrono::steady_clock::now()};
+      function(output);
+      const std::chrono::duration<double, std::micro> duration{
+          std::chrono::steady_clock::now() - start};
+      best = std::min(best, duration.count());
+    }
+  return best;
+}
+
+bool same_order(const entries& a, const entries& b)
+{
+  for (size_t it{0}; it < a.size(); it++)
+    if (a[it].index != b[it].index) return false;
+  return true;
+}
+}  // namespace
+
+int main()
+{
+  render::draw_list::sort_buffers buffers{};
+  const auto radix_sort{[&buffers](entries& items) {
+    render::draw_list::sort_entries(items, buffers);
+  }};
+  const auto std_sort{[](entries& items) {
+    std::stable_sort(items.begin(), items.end(),
+                     [](const render::draw_list::entry& a,
+                        const render::draw_list::entry& b) {
+                       return a.key < b.key;
+                     });
+  }};
+
+  for (size_t count : {size_t{1000}, size_t{10000}, size_t{100000}})
+    for (bool random : {false, true})
+      {
+        const entries input{random ? make_random(count) : make_frame(count)};
+        entries reference{};
+        entries sorted{};
+
+        const double std_time{measure(std_sort, input, reference)};
+        const double radix_time{measure(radix_sort, input, sorted)};
+
+        std::cout << count << (random ? " random keys" : " frame keys")
+                  << ": std::stable_sort " << std_time << " us, radix "
+                  << radix_time << " us (x" << std_time / radix_time << "), "
+                  << (same_order(reference, sorted) ? "same order"
+                                                    : "ORDER MISMATCH")
+                  << std::endl;
+      }
+  return 0;
+}
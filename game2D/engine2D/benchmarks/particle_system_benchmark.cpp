@@ -0,0 +1,62 @@
+#include <render/particle_system.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+// Benchmark of particle_system::update on a single thread and on worker
+// threads. The system is created without a program, so only the
+// simulation is measured and no gl context is needed
+
+namespace
+{
+constexpr int warmup_frames{200};
+constexpr int measured_frames{300};
+constexpr double frame_ms{16.0};
+
+render::particle_emitter make_emitter(float rate, unsigned int capacity)
+{
+  render::particle_emitter emitter{};
+  emitter.rate = rate;
+  emitter.capacity = capacity;
+  emitter.lifetime = {1.5f, 2.5f};
+  emitter.velocity_min = {-1.f, -1.f};
+  emitter.velocity_max = {1.f, 1.f};
+  emitter.acceleration = {0.f, -1.f};
+  emitter.size = {0.02f, 0.005f};
+  emitter.color_end = {1.f, 0.f, 0.f, 0.f};
+  // the animation frames are advanced, but never rendered
+  emitter.frames.resize(4);
+  return emitter;
+}
+}  // namespace
+
+int main()
+{
+  for (unsigned int workers : {0u, 2u, 4u})
+    {
+      render::particle_system system{nullptr, workers};
+      // two emitters of ~50k live particles each
+      system.add_emitter(make_emitter(25000.f, 60000));
+      system.add_emitter(make_emitter(25000.f, 60000));
+
+      for (int frame{0}; frame < warmup_frames; frame++)
+        system.update(frame_ms);
+
+      double best{1e30};
+      double total{0};
+      for (int frame{0}; frame < measured_frames; frame++)
+        {
+          const auto start{std::chrono::steady_clock::now()};
+          system.update(frame_ms);
+          const std::chrono::duration<double, std::milli> duration{
+              std::chrono::steady_clock::now() - start};
+          best = std::min(best, duration.count());
+          total += duration.count();
+        }
+
+      std::cout << workers << " workers, " << system.get_count()
+                << " live particles: update " << total / measured_frames
+                << " ms average, " << best << " ms best" << std::endl;
+    }
+  return 0;
+}
@@ -0,0 +1,116 @@
+#include <render/simd.h>
+#include <render/sprite_transform.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Microbenchmark of the sprite transform kernel against the per-sprite glm
+// matrix path used by sprite2D before batching
+
+namespace
+{
+constexpr int repeats{50};
+
+render::sprite_transform_input make_input(size_t count)
+{
+  std::mt19937 random{42};
+  std::uniform_real_distribution<float> position{-1000.f, 1000.f};
+  std::uniform_real_distribution<float> size{1.f, 128.f};
+  std::uniform_real_distribution<float> rotation{-720.f, 720.f};
+
+  render::sprite_transform_input input{};
+  for (size_t it{0}; it < count; it++)
+    {
+      render::render_settings settings{};
+      settings.position = {position(random), position(random)};
+      settings.size = {size(random), size(random)};
+      settings.rotation = rotation(random);
+      input.push_back(settings);
+    }
+  return input;
+}
+
+void transform_glm(const render::sprite_transform_input& input,
+                   float* corners, size_t stride)
+{
+  const glm::vec4 quad[4]{{0, 0, 0, 1}, {0, 1, 0, 1}, {1, 0, 0, 1},
+                          {1, 1, 0, 1}};
+  for (size_t sprite{0}; sprite < input.size(); sprite++)
+    {
+      const glm::vec2 position{input.x[sprite], input.y[sprite]};
+      const glm::vec2 size{input.width[sprite], input.height[sprite]};
+
+      glm::mat4x4 model{1};
+      model = glm::translate(model, glm::vec3{position + size * 0.5f, 0});
+      model = glm::rotate(model, glm::radians(input.rotation[sprite]),
+                          glm::vec3{0, 0, 1});
+      model = glm::translate(model, glm::vec3{size * -0.5f, 0});
+      model = glm::scale(model, glm::vec3{size, 1});
+
+      float* out{corners + sprite * 4 * stride};
+      for (size_t corner{0}; corner < 4; corner++)
+        {
+          const glm::vec4 result{model * quad[corner]};
+          out[corner * stride] = result.x;
+          out[corner * stride + 1] = result.y;
+        }
+    }
+}
+
+template <typename kernel>
+double measure(kernel function, const render::sprite_transform_input& input,
+               std::vector<float>& corners)
+{
+  double best{1e30};
+  for (int repeat{0}; repeat < repeats; repeat++)
+    {
+      const auto start{std::chrono::steady_clock::now()};
+      function(input, corners.data(), 4);
+      const std::chrono::duration<double, std::micro> duration{
+          std::chrono::steady_clock::now() - start};
+      best = std::min(best, duration.count());
+    }
+  return best;
+}
+
+float max_difference(const std::vector<float>& a, const std::vector<float>& b)
+{
+  float result{0};
+  for (size_t it{0}; it < a.size(); it++)
+    result = std::max(result, std::abs(a[it] - b[it]));
+  return result;
+}
+}  // namespace
+
+int main()
+{
+  std::cout << "instruction set: " << render::simd::instruction_set()
+            << std::endl;
+
+  for (size_t count : {size_t{1000}, size_t{10000}, size_t{100000}})
+    {
+      const render::sprite_transform_input input{make_input(count)};
+      // 4 vertices of position + uv per sprite, as in the sprite batch
+      std::vector<float> reference(count * 4 * 4);
+      std::vector<float> scalar(count * 4 * 4);
+      std::vector<float> kernel(count * 4 * 4);
+
+      const double glm_time{measure(transform_glm, input, reference)};
+      const double scalar_time{measure(
+          render::sprite_transform::transform_quads_scalar, input, scalar)};
+      const double kernel_time{
+          measure(render::sprite_transform::transform_quads, input, kernel)};
+
+      std::cout << count << " sprites: glm " << glm_time << " us, scalar "
+                << scalar_time << " us, kernel " << kernel_time
+                << " us (x" << glm_time / kernel_time
+                << "), max error " << max_difference(reference, kernel)
+                << std::endl;
+    }
+  return 0;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <glad/glad.h>
+#include <render/animated_instances.h>
+#include <render/index_buffer.h>
+#include <render/shader_program.h>
+#include <render/vertex_array.h>
+#include <render/vertex_buffer.h>
+#include <render/vertex_buffer_descriptor.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <memory>
+#include <vector>
+namespace render
+{
+struct animated_instances::instances_impl
+{
+  /*!
+   * \brief Данные одного экземпляра в буфере экземпляров
+   */
+  struct instance
+  {
+    glm::vec4 position_size;   ///< положение (xy) и размер (zw)
+    glm::vec2 rotation_layer;  ///< угол поворота (x) и слой (y)
+    glm::vec2 clip_start;  ///< номер клипа (x) и время начала в секундах (y)
+  };
+
+  /*!
+   * \brief gl-объекты набора
+   * \note Создаются и используются потоком, выполняющим команды отрисовки
+   */
+  struct gpu_state
+  {
+    gpu_state();
+    ~gpu_state();
+
+    gpu_state(gpu_state&) = delete;
+    gpu_state& operator=(gpu_state&) = delete;
+
+    vertex_array vao{};
+    vertex_buffer quad_vbo{};
+    vertex_buffer instance_vbo{buffer_usage::dynamic_draw};
+    index_buffer vebo{};
+    GLuint table{0};  ///< текстура таблицы клипов rgba32f
+  };
+
+  /*!
+   * \brief Ширина таблицы клипов в текселях
+   */
+  static constexpr unsigned int table_width{256};
+
+  /*!
+   * \brief Сборка таблицы клипов
+   * Таблица начинается с заголовков клипов (первый тексель кадров,
+   * количество кадров, продолжительность в секундах, признак остановки), за
+   * ними следуют кадры: по два текселя на кадр - область текстуры и время
+   * окончания кадра в секундах
+   */
+  std::vector<glm::vec4> build_table() const;
+
+  /*!
+   * \brief Загрузка изменений и отрисовка
+   * \note Выполняется командой отрисовки. Пустые table и instances не
+   * загружаются
+   */
+  void draw(shader_program& program, texture2D& atlas, unsigned int count,
+            const std::vector<glm::vec4>& table,
+            const std::vector<instance>& instances);
+
+  std::vector<std::vector<sprite_animator::frame>> clips{};
+  std::vector<instance> instances{};
+
+  /// \name Состояние игрового потока
+  ///@{
+  bool table_dirty{false};
+  bool instances_dirty{false};
+  bool bounds_dirty{false};
+  int min_layer{0};  ///< слой сортировки набора
+  glm::vec2 bounds_min{0};
+  glm::vec2 bounds_max{0};
+  blend_mode blend{blend_mode::translucent};
+  ///@}
+
+  std::unique_ptr<gpu_state> gpu{};
+  uniform<int> texture{};
+  uniform<int> animation_table{};
+  bool uniforms_resolved{false};
+};
+}  // namespace render
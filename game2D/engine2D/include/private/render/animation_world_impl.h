@@ -0,0 +1,55 @@
+#pragma once
+#include <render/animation_world.h>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+namespace render
+{
+struct animation_world::world_impl
+{
+  /*!
+   * \brief Клип, подготовленный к обновлению
+   */
+  struct clip_data
+  {
+    animation_clip clip{};
+    std::vector<float> frame_ends{};  ///< время окончания каждого кадра
+    float duration{0};                ///< продолжительность клипа
+  };
+
+  static constexpr unsigned int no_instance{~0u};
+
+  /*!
+   * \brief Перевод времени экземпляра в кадр клипа
+   * Переходит через любое количество кадров. Время повторяемого клипа
+   * переносится в его продолжительность, неповторяемый клип
+   * останавливается на границе
+   * \note Продолжительность клипа должна быть больше нуля
+   */
+  static void seek(const clip_data& data, float& time, std::uint32_t& frame,
+                   std::uint8_t& playing);
+
+  std::vector<clip_data> clips{};
+
+  /// \name Экземпляры, плотные массивы
+  ///@{
+  std::vector<clip_id> clip{};
+  std::vector<float> time{};   ///< время от начала клипа
+  std::vector<float> speed{};
+  std::vector<std::uint32_t> frame{};
+  std::vector<std::uint8_t> playing{};
+  std::vector<render_settings> settings{};
+  std::vector<instance_id> owner{};  ///< номер экземпляра элемента
+  ///@}
+
+  std::vector<unsigned int> dense_index{};  ///< номер экземпляра - элемент
+  std::vector<instance_id> free_ids{};
+
+  unsigned int index_of(instance_id instance) const
+  {
+    assert(instance < dense_index.size() &&
+           dense_index[instance] != no_instance && "unknown instance id");
+    return dense_index[instance];
+  }
+};
+}  // namespace render
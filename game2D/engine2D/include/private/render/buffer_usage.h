@@ -0,0 +1,31 @@
+#pragma once
+#include <glad/glad.h>
+namespace render
+{
+/*!
+ * \brief Способ использования gl-буфера
+ * Подсказка драйверу о частоте изменения данных буфера
+ */
+enum class buffer_usage
+{
+  static_draw,   ///< данные загружаются один раз
+  dynamic_draw,  ///< данные изменяются время от времени
+  stream_draw    ///< данные перезаписываются каждый кадр
+};
+
+/*!
+ * \brief Соответствующая gl-константа способа использования
+ */
+inline GLenum to_gl_usage(buffer_usage usage)
+{
+  switch (usage)
+    {
+      case buffer_usage::dynamic_draw:
+        return GL_DYNAMIC_DRAW;
+      case buffer_usage::stream_draw:
+        return GL_STREAM_DRAW;
+      default:
+        return GL_STATIC_DRAW;
+    }
+}
+}  // namespace render
@@ -0,0 +1,48 @@
+#pragma once
+#include <render/cached_layer.h>
+#include <render/camera2D.h>
+#include <render/command_list.h>
+#include <render/draw_list.h>
+#include <render/framebuffer.h>
+#include <render/shader_program.h>
+#include <render/sprite_quad.h>
+#include <atomic>
+#include <memory>
+namespace render
+{
+struct cached_layer::layer_impl
+{
+  /*!
+   * \brief Перерисовка текстуры и вывод слоя
+   * \param contents    записанное содержимое, nullptr - текстура
+   * действительна
+   * \param blend       класс смешивания вывода, восстанавливается после
+   * перерисовки
+   * \note Выполняется командой отрисовки
+   */
+  void draw(shader_program& program, draw_list* contents,
+            const glm::mat4x4& view_projection,
+            const sprite_quad::instance& quad, blend_mode blend);
+
+  ~layer_impl();
+
+  command_list list{0};  ///< список записи содержимого
+  camera2D camera{};     ///< камера области содержимого
+  glm::ivec2 resolution{0};
+  bool valid{false};
+  /*!
+   * \brief Перерисовка текстуры не выполнена
+   * \note Устанавливается командой отрисовки, сбрасывается при записи
+   * содержимого
+   */
+  std::atomic<bool> failed{false};
+
+  /*!
+   * \brief Текстура слоя
+   * \note Принадлежит потоку, выполняющему команды отрисовки
+   */
+  std::unique_ptr<framebuffer> target{};
+  uniform<int> texture{};
+  bool uniforms_resolved{false};
+};
+}  // namespace render
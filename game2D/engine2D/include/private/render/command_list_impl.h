@@ -0,0 +1,14 @@
+#pragma once
+#include <render/camera2D.h>
+#include <render/command_list.h>
+#include <render/draw_list.h>
+namespace render
+{
+struct command_list::list_impl
+{
+  draw_list list{};
+  camera2D camera{};  ///< снимок камеры рендера на начало записи
+  unsigned int drawn_sprites{0};
+  unsigned int culled_sprites{0};
+};
+}  // namespace render
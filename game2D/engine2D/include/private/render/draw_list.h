@@ -0,0 +1,184 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <render/shader_program.h>
+#include <render/sprite_quad.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+namespace render
+{
+class texture2D;
+
+/*!
+ * \brief Список отрисовки кадра
+ * Хранит все элементы, отправленные на отрисовку в течение кадра, вместе с
+ * 64-битными ключами сортировки. Перед отрисовкой список сортируется
+ * поразрядной сортировкой, что группирует элементы по классу смешивания,
+ * слою, программе и текстуре и делает порядок отрисовки детерминированным.
+ * \note Структура ключа (от старших битов к младшим):
+ * - 2 бита  - класс смешивания (render::blend_mode)
+ * - 8 бит   - слой отрисовки (render_settings::layer + 128), для
+ * непрозрачных элементов инвертирован
+ * - 10 бит  - глубина внутри слоя (render_settings::depth), инвертирована
+ * - 10 бит  - шейдерная программа
+ * - 14 бит  - текстура
+ * - 20 бит  - порядковый номер элемента в кадре
+ * \note Непрозрачные элементы отрисовываются первыми, от ближних слоев к
+ * дальним, чтобы тест глубины отбрасывал перекрытые пиксели до выполнения
+ * фрагментного шейдера. Остальные классы отрисовываются от дальних слоев к
+ * ближним. Внутри слоя элементы всех классов отрисовываются от дальних к
+ * ближним
+ * \note Элементы одного слоя и одной глубины с одинаковыми программой и
+ * текстурой отрисовываются в порядке отправки
+ * \note Кадр из более чем 2^20 элементов сортируется медленной
+ * сортировкой слиянием
+ */
+class draw_list
+{
+ public:
+  /*!
+   * \brief Тип элемента списка
+   */
+  enum class item_type : std::uint8_t
+  {
+    sprite,     ///< спрайт пакетного рендера
+    instances,  ///< инстансная отрисовка квада
+    command     ///< произвольная команда отрисовки
+  };
+
+  /*!
+   * \brief Элемент сортировки
+   */
+  struct entry
+  {
+    std::uint64_t key;
+    std::uint32_t index;  ///< номер элемента в хранилище своего типа
+    item_type type;
+  };
+
+  /*!
+   * \brief Спрайт пакетного рендера
+   */
+  struct sprite_item
+  {
+    shader_program* program;
+    const texture2D* texture;
+    render_settings settings;
+    frame_descriptor frame;
+  };
+
+  /*!
+   * \brief Инстансная отрисовка квада
+   */
+  struct instances_item
+  {
+    shader_program* program;
+    const texture2D* texture;
+    uniform<int> texture_uniform;  ///< поле s_texture программы
+    std::uint32_t first;  ///< номер первого экземпляра в хранилище кадра
+    std::uint32_t count;  ///< количество экземпляров
+  };
+
+  void add_sprite(shader_program& program, const texture2D& texture,
+                  const render_settings& settings,
+                  const frame_descriptor& frame);
+  /*!
+   * \note Данные экземпляров копируются в хранилище кадра
+   */
+  void add_instances(shader_program& program, const texture2D& texture,
+                     const uniform<int>& texture_uniform, int layer,
+                     blend_mode blend,
+                     const sprite_quad::instance* data, std::uint32_t count);
+  void add_command(int layer, blend_mode blend, std::function<void()> command);
+
+  /*!
+   * \brief Перенос элементов другого списка
+   * Добавляет элементы other в конец списка в порядке их добавления в
+   * other, назначая им новые порядковые номера, и очищает other
+   * \note Результат сортировки не зависит от того, когда был заполнен
+   * other, а только от порядка вызовов append
+   */
+  void append(draw_list& other);
+
+  /*!
+   * \brief Рабочие буферы сортировки
+   * Сохраняются между кадрами, чтобы сортировка не выделяла память
+   */
+  struct sort_buffers
+  {
+    std::vector<entry> entries{};
+    std::vector<std::uint64_t> keys{};
+    std::vector<std::uint64_t> swap_keys{};
+    std::vector<std::uint32_t> histograms{};
+  };
+
+  /*!
+   * \brief Поразрядная сортировка элементов по ключу
+   * \note Сортировка устойчива, поэтому младшие биты порядкового номера не
+   * сортируются: элементы уже добавлены в порядке отправки
+   */
+  void sort() { sort_entries(entries, buffers); }
+  /*!
+   * \brief Поразрядная сортировка элементов
+   * Сортируются только биты ключа, различающиеся между элементами: они
+   * собираются в плотный ключ и сортируются цифрами до 11 бит, поэтому кадр
+   * с несколькими слоями, программами и текстурами сортируется за один-два
+   * прохода. Последний проход переносит сами элементы
+   * \param items     элементы в порядке отправки
+   * \param buffers   рабочие буферы
+   */
+  static void sort_entries(std::vector<entry>& items, sort_buffers& buffers);
+
+  void clear();
+
+  bool empty() const { return entries.empty(); }
+  size_t size() const { return entries.size(); }
+
+  const std::vector<entry>& get_entries() const { return entries; }
+  const std::vector<sprite_item>& get_sprites() const { return sprites; }
+  const std::vector<instances_item>& get_instances() const
+  {
+    return instances;
+  }
+  const std::vector<sprite_quad::instance>& get_instance_data() const
+  {
+    return instance_data;
+  }
+  const std::function<void()>& get_command(std::uint32_t index) const
+  {
+    return commands[index];
+  }
+
+  /*!
+   * \brief Построение ключа сортировки
+   */
+  static std::uint64_t make_key(int layer, blend_mode blend, float depth,
+                                unsigned int program, unsigned int texture,
+                                std::uint64_t sequence);
+  /*!
+   * \brief Класс смешивания элемента
+   */
+  static blend_mode get_blend(const entry& item)
+  {
+    return static_cast<blend_mode>(item.key >> 62);
+  }
+
+  static constexpr unsigned int sequence_bits{20};
+
+ private:
+  static unsigned int program_id(const shader_program& program);
+  static unsigned int texture_id(const texture2D& texture);
+
+  std::uint64_t next_sequence() { return sequence++; }
+
+  std::vector<entry> entries{};
+  sort_buffers buffers{};
+
+  std::vector<sprite_item> sprites{};
+  std::vector<instances_item> instances{};
+  std::vector<sprite_quad::instance> instance_data{};
+  std::vector<std::function<void()>> commands{};
+
+  std::uint64_t sequence{0};
+};
+}  // namespace render
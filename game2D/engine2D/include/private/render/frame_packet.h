@@ -0,0 +1,41 @@
+#pragma once
+#include <render/draw_list.h>
+#include <render/frame_stats.h>
+#include <render/post_process.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+namespace render
+{
+/*!
+ * \brief Содержимое uniform-блока данных кадра
+ * \note Раскладка std140, совпадает с блоком frame_data шейдеров
+ * \sa render::renderer::frame_block_name
+ */
+struct frame_uniforms
+{
+  glm::mat4x4 view_projection{1};
+  glm::vec4 time{0};      ///< время от запуска (x) и длительность кадра (y)
+  glm::vec4 viewport{0};  ///< размер цели сцены (xy) и обратный (zw)
+};
+
+/*!
+ * \brief Записанный кадр
+ * Все, что необходимо потоку рендера для отрисовки кадра без обращения к
+ * данным игрового потока: список отрисовки, снимок данных кадра и
+ * состояние, которое игра меняет через renderer
+ * \sa render::render_thread
+ */
+struct frame_packet
+{
+  draw_list list{};
+  frame_uniforms frame{};
+  glm::ivec4 viewport{0};     ///< область отрисовки: x, y, ширина, высота
+  glm::vec4 clear_color{0};   ///< цвет очистки back-буфера
+  frame_stats stats{};        ///< счетчики, собранные при записи кадра
+  bool capture{false};        ///< снять пиксели кадра перед переключением
+  std::vector<post_process_pass> post_process{};  ///< цепочка постобработки
+  bool post_profile{false};  ///< профилирование проходов постобработки
+  float resolution_scale{1.f};  ///< масштаб разрешения кадра
+};
+}  // namespace render
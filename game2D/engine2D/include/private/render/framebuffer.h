@@ -0,0 +1,63 @@
+#pragma once
+#include <glad/glad.h>
+namespace render
+{
+/*!
+ * \brief Буфер кадра (fbo)
+ * Оболочка gl-буфера кадра с цветовым вложением в виде текстуры rgba и
+ * необязательным буфером глубины. Используется как цель отрисовки вместо
+ * back-буфера окна.
+ * \note Текстура цветового вложения принадлежит буферу кадра
+ */
+class framebuffer
+{
+ public:
+  /*!
+   * \brief Инициализация
+   * \param width   ширина в пикселях
+   * \param height  высота в пикселях
+   * \param depth   true - создать буфер глубины
+   * \note При ошибке создания в log выводится сообщение, а
+   * framebuffer::is_complete() возвращает false
+   */
+  framebuffer(int width, int height, bool depth = true);
+
+  /*!
+   * \brief Активация буфера кадра как цели отрисовки
+   */
+  void bind() const;
+
+  /*!
+   * \brief Состояние буфера кадра
+   * \return true - буфер кадра готов к отрисовке
+   */
+  bool is_complete() const { return complete; }
+
+  GLuint get_id() const { return id; }
+  /*!
+   * \brief Текстура цветового вложения
+   */
+  GLuint get_color_texture() const { return color; }
+  int get_width() const { return width; }
+  int get_height() const { return height; }
+  bool has_depth() const { return depth_buffer != 0; }
+
+  ~framebuffer();
+
+  framebuffer(framebuffer&&);
+  framebuffer& operator=(framebuffer&&);
+
+  framebuffer(framebuffer&) = delete;
+  framebuffer& operator=(framebuffer&) = delete;
+
+ private:
+  void release();
+
+  GLuint id{0};
+  GLuint color{0};
+  GLuint depth_buffer{0};
+  int width{0};
+  int height{0};
+  bool complete{false};
+};
+}  // namespace render
@@ -1,5 +1,6 @@
 #pragma once
 #include <glad/glad.h>
+#include <render/buffer_usage.h>
 #include <string>
 namespace render
 {
@@ -14,14 +15,17 @@ class index_buffer
  public:
   /*!
    * \brief Инициализация пустым буфером
+   * \param usage   способ использования буфера
    */
-  index_buffer();
+  explicit index_buffer(buffer_usage usage = buffer_usage::static_draw);
   /*!
    * \brief Инициализация
    * \param count   количество элементов в массиве
    * \param data    указатель на элементы массива
+   * \param usage   способ использования буфера
    */
-  index_buffer(const unsigned int count, const unsigned int* data);
+  index_buffer(const unsigned int count, const unsigned int* data,
+               buffer_usage usage = buffer_usage::static_draw);
 
   /*!
    * \brief Активация буфера
@@ -45,6 +49,7 @@ class index_buffer
    * \param data    указатель на элементы массива
    * \note Данные data могут быть удалены после использования
    * \note Буфер автоматически выполняет команду render::index_buffer::bind()
+   * после деактивации vao, чтобы не изменить привязку активного vao
    * \sa render::index_buffer::bind()
    */
   void restore(const unsigned int count, const unsigned int* data);
@@ -57,6 +62,10 @@ class index_buffer
    * \param data    указатель на элементы массива
    * \note Данные data могут быть удалены после использования
    * \note Буфер автоматически выполняет команду render::index_buffer::bind()
+   * после деактивации vao, чтобы не изменить привязку активного vao
+   * \note Динамические и потоковые буферы перед записью освобождают старое
+   * хранилище (orphaning), поэтому запись не ожидает завершения отрисовок,
+   * использующих прежние данные
    * \sa render::index_buffer::bind()
    */
   void update(const unsigned int count, const unsigned int* data);
@@ -78,6 +87,8 @@ class index_buffer
  private:
   GLuint id{0};
   unsigned int count{0};
+  unsigned int capacity{0};  ///< количество элементов в хранилище буфера
+  buffer_usage usage{buffer_usage::static_draw};
 
   static const GLenum buffer_type{GL_ELEMENT_ARRAY_BUFFER};
   static const GLuint element_size{sizeof(GLuint)};
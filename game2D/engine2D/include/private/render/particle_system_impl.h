@@ -0,0 +1,82 @@
+#pragma once
+#include <render/particle_system.h>
+#include <render/shader_program.h>
+#include <render/sprite_quad.h>
+#include <render/worker_pool.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+namespace render
+{
+struct particle_system::system_impl
+{
+  /*!
+   * \brief Пул частиц излучателя
+   * Свойства частиц хранятся отдельными массивами. Живые частицы занимают
+   * начало массивов, умершие замещаются последними живыми
+   * \note Размер массивов кратен четырем, поэтому векторное обновление
+   * обрабатывает хвост без отдельного скалярного цикла
+   */
+  struct pool
+  {
+    void reserve(unsigned int capacity);
+    /*!
+     * \brief Удаление частицы с переносом последней живой на ее место
+     */
+    void remove(unsigned int index);
+
+    std::vector<float> x{};
+    std::vector<float> y{};
+    std::vector<float> velocity_x{};
+    std::vector<float> velocity_y{};
+    std::vector<float> life{};              ///< оставшееся время жизни
+    std::vector<float> inverse_lifetime{};  ///< 1 / полное время жизни
+    std::vector<float> size{};
+    std::vector<float> red{};
+    std::vector<float> green{};
+    std::vector<float> blue{};
+    std::vector<float> alpha{};
+    std::vector<float> frame{};  ///< положение в кадрах анимации
+
+    unsigned int count{0};
+    unsigned int capacity{0};
+  };
+
+  /*!
+   * \brief Излучатель с пулом частиц
+   */
+  struct emitter_state
+  {
+    particle_emitter settings{};
+    pool particles{};
+    float spawn_debt{0};  ///< накопленная дробная часть рождаемых частиц
+    std::uint32_t random{0};  ///< состояние генератора xorshift32
+  };
+
+  /*!
+   * \brief Часть обновления: диапазон частиц одного излучателя
+   */
+  struct slice
+  {
+    unsigned int emitter;
+    unsigned int first;
+    unsigned int last;
+  };
+
+  void spawn(emitter_state& emitter, unsigned int count);
+  /*!
+   * \brief Векторное обновление диапазона частиц
+   * \note first и last кратны четырем
+   */
+  static void simulate(emitter_state& emitter, unsigned int first,
+                       unsigned int last, float delta);
+
+  std::vector<emitter_state> emitters{};
+  std::unique_ptr<worker_pool> workers{};
+  std::vector<slice> slices{};
+
+  std::vector<unsigned int> order{};  ///< излучатели в порядке групп
+  std::vector<sprite_quad::instance> instances{};
+  uniform<int> texture_uniform{};
+};
+}  // namespace render
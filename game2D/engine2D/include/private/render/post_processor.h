@@ -0,0 +1,91 @@
+#pragma once
+#include <glad/glad.h>
+#include <render/frame_stats.h>
+#include <render/framebuffer.h>
+#include <render/index_buffer.h>
+#include <render/post_process.h>
+#include <render/shader_program.h>
+#include <render/vertex_array.h>
+#include <render/vertex_buffer.h>
+#include <glm/vec4.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+namespace render
+{
+/*!
+ * \brief Исполнитель цепочки постобработки
+ * Перенаправляет отрисовку кадра в цель отрисовки размером с область
+ * отрисовки, а после отрисовки кадра выполняет полноэкранные проходы
+ * цепочки. Цели отрисовки кадра и проходов берутся из пула рендера на один
+ * кадр.
+ * \note Используется потоком, владеющим gl-контекстом
+ * \sa render::post_process_pass
+ */
+class post_processor
+{
+ public:
+  post_processor();
+
+  /*!
+   * \brief Начало отрисовки кадра в цель отрисовки
+   * Привязывает цель кадра и устанавливает область отрисовки (0, 0,
+   * ширина, высота)
+   * \param viewport    область отрисовки кадра в окне
+   * \param scale       масштаб разрешения цели кадра относительно viewport
+   * \return false - цель отрисовки не получена, кадр отрисовывается в окно
+   */
+  bool begin(const glm::ivec4& viewport, float scale);
+  /*!
+   * \brief Область отрисовки цели кадра
+   */
+  glm::ivec4 get_scene_viewport() const;
+  /*!
+   * \brief Выполнение проходов
+   * Записывает результат последнего прохода в буфер кадра output в области
+   * viewport и возвращает цели отрисовки в пул. Без проходов кадр
+   * растягивается в output копированием буфера кадра
+   * \param passes      проходы цепочки
+   * \param output      буфер кадра окна
+   * \param viewport    область отрисовки кадра в окне
+   * \param profile     true - ожидать завершения каждого прохода, чтобы
+   * время прохода включало работу видеокарты
+   * \param stats       статистика кадра, в нее записывается время проходов
+   */
+  void finish(const std::vector<post_process_pass>& passes, GLuint output,
+              const glm::ivec4& viewport, bool profile, frame_stats& stats);
+
+  bool is_active() const { return scene != nullptr; }
+
+  post_processor(post_processor&) = delete;
+  post_processor& operator=(post_processor&) = delete;
+
+ private:
+  /*!
+   * \brief Дескрипторы полей программы прохода
+   */
+  struct pass_uniforms
+  {
+    uniform<int> texture{};
+    uniform<int> scene{};
+    uniform<glm::vec2> texel{};
+    uniform<glm::vec4> parameters{};
+    bool scene_resolved{false};
+  };
+
+  pass_uniforms& get_uniforms(const post_process_pass& pass);
+
+  /*!
+   * \brief Копирование цели в область вывода с масштабированием
+   */
+  static void blit(const framebuffer& source, GLuint output,
+                   const glm::ivec4& viewport);
+
+  vertex_array vao{};
+  vertex_buffer vbo{};
+  index_buffer vebo{};
+
+  std::unique_ptr<framebuffer> scene{};  ///< цель кадра текущего кадра
+  std::unordered_map<const shader_program*, pass_uniforms> uniforms{};
+};
+}  // namespace render
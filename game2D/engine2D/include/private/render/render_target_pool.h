@@ -0,0 +1,49 @@
+#pragma once
+#include <render/framebuffer.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+namespace render
+{
+/*!
+ * \brief Пул целей отрисовки
+ * Хранит освобожденные буферы кадра и выдает их повторно по размеру и
+ * формату, поэтому временные цели отрисовки не создаются заново при каждом
+ * использовании.
+ * \note Освобождать буферы можно из любого потока, а получать - только в
+ * потоке, владеющем gl-контекстом
+ * \sa render::renderer::acquire_target
+ */
+class render_target_pool
+{
+ public:
+  render_target_pool() = default;
+
+  /*!
+   * \brief Получение буфера кадра
+   * \param width   ширина в пикселях
+   * \param height  высота в пикселях
+   * \param depth   true - буфер кадра с буфером глубины
+   * \return Свободный буфер кадра подходящего формата или новый буфер,
+   * nullptr - буфер кадра не удалось создать
+   */
+  std::unique_ptr<framebuffer> acquire(int width, int height, bool depth);
+  /*!
+   * \brief Возврат буфера кадра в пул
+   */
+  void release(std::unique_ptr<framebuffer> target);
+  /*!
+   * \brief Удаление всех свободных буферов кадра
+   */
+  void clear();
+
+  size_t get_free_count() const;
+
+  render_target_pool(render_target_pool&) = delete;
+  render_target_pool& operator=(render_target_pool&) = delete;
+
+ private:
+  mutable std::mutex mutex{};
+  std::vector<std::unique_ptr<framebuffer>> free_targets{};
+};
+}  // namespace render
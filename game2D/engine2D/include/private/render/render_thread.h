@@ -0,0 +1,76 @@
+#pragma once
+#include <render/frame_packet.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+namespace render
+{
+/*!
+ * \brief Поток рендера
+ * Владеет gl-контекстом окна и выполняет записанные игровым потоком кадры.
+ * Кадры передаются через двойной буфер: пока поток рендера отрисовывает
+ * кадр N, игровой поток обновляет мир и записывает кадр N + 1. Передача
+ * следующего кадра ожидает завершения отрисовки предыдущего, поэтому
+ * игровой поток опережает поток рендера не более чем на один кадр.
+ * \note Хранилища пакетов переиспользуются: при передаче кадра игровой поток
+ * получает обратно пакет отрисованного кадра
+ */
+class render_thread
+{
+ public:
+  /*!
+   * \brief Инициализация потока
+   * \param attach      делает gl-контекст текущим для потока рендера
+   * \param execute     отрисовывает пакет и переключает back-буфер
+   * \param detach      освобождает gl-контекст перед завершением потока
+   * \note Поток запускается сразу. Перед запуском игровой поток должен
+   * освободить gl-контекст
+   */
+  render_thread(std::function<void()> attach,
+                std::function<void(frame_packet&)> execute,
+                std::function<void()> detach);
+
+  /*!
+   * \brief Передача записанного кадра
+   * Ожидает завершения отрисовки предыдущего кадра и обменивает пакет с
+   * пакетом отрисованного кадра
+   * \param packet  записанный кадр, после вызова - очищенный пакет для
+   * записи следующего кадра
+   */
+  void submit(frame_packet& packet);
+
+  /*!
+   * \brief Статистика последнего отрисованного кадра
+   */
+  frame_stats get_stats();
+
+  /*!
+   * \brief Остановка потока
+   * Дожидается отрисовки переданного кадра и завершения потока
+   */
+  void stop();
+
+  ~render_thread();
+
+  render_thread(render_thread&) = delete;
+  render_thread& operator=(render_thread&) = delete;
+
+ private:
+  void run();
+
+  std::function<void()> attach;
+  std::function<void(frame_packet&)> execute;
+  std::function<void()> detach;
+
+  std::mutex mutex{};
+  std::condition_variable condition{};
+  frame_packet pending{};       ///< переданный или отрисовываемый кадр
+  bool has_pending{false};      ///< кадр передан и ожидает отрисовки
+  bool busy{false};             ///< кадр отрисовывается
+  bool stopping{false};
+  frame_stats last_stats{};
+
+  std::thread thread{};
+};
+}  // namespace render
@@ -1,11 +1,32 @@
 #pragma once
 #include <glad/glad.h>
+#include <render/camera2D.h>
+#include <render/frame_packet.h>
+#include <render/frame_stats.h>
+#include <render/frame_structures.h>
+#include <render/post_process.h>
+#include <render/sprite_quad.h>
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace render
 {
 class vertex_array;
 class index_buffer;
 class shader_program;
+class texture2D;
+class sprite_batch;
+class uniform_buffer;
+class render_thread;
+class command_list;
+class framebuffer;
+class render_target_pool;
+class draw_list;
+class post_processor;
+class resolution_controller;
 
 /*!
  * \brief Рендер-менеджер
@@ -26,6 +47,193 @@ class renderer
    */
   static void draw(const vertex_array& vao, const index_buffer& vebo,
                    const shader_program& program, GLenum mode = GL_TRIANGLES);
+  /*!
+   * \brief Отрисовка диапазона индексов в back-буфер
+   * \param vao     используемый массив атрибутов
+   * \param vebo    используемый массив индексов
+   * \param program используемая шейдерная программа
+   * \param count   количество отрисовываемых индексов
+   * \param first   номер первого отрисовываемого индекса
+   * \param mode    режим отрисовки
+   */
+  static void draw(const vertex_array& vao, const index_buffer& vebo,
+                   const shader_program& program, unsigned int count,
+                   unsigned int first, GLenum mode = GL_TRIANGLES);
+
+  /*!
+   * \brief Инстансная отрисовка в back-буфер
+   * Отрисовывает instance_count копий геометрии одним вызовом. Данные
+   * экземпляров берутся из буферов, привязанных к vao с ненулевым делителем.
+   * \param vao             используемый массив атрибутов
+   * \param vebo            используемый массив индексов
+   * \param program         используемая шейдерная программа
+   * \param instance_count  количество экземпляров
+   * \param mode            режим отрисовки
+   * \sa render::vertex_array::bind_vertex_buffer
+   */
+  static void draw_instanced(const vertex_array& vao, const index_buffer& vebo,
+                             const shader_program& program,
+                             unsigned int instance_count,
+                             GLenum mode = GL_TRIANGLES);
+
+  /*!
+   * \brief Инициализация ресурсов рендера
+   * \param batching   true - спрайты отрисовываются пакетами
+   * \note Вызывается после создания контекста окна
+   */
+  static void init(bool batching);
+  /*!
+   * \brief Освобождение ресурсов рендера
+   * \note Вызывается до удаления контекста окна
+   */
+  static void dispose();
+
+  /*!
+   * \brief Состояние пакетной отрисовки
+   * \return true - спрайты накапливаются в пакете и отрисовываются при вызове
+   * renderer::flush()
+   */
+  static bool is_batching() { return batching; }
+  /*!
+   * \brief Камера рендера
+   * \sa render::camera2D
+   */
+  static camera2D& get_camera() { return camera; }
+  /*!
+   * \brief Имя uniform-блока данных кадра
+   * Программы, использующие блок с этим именем, связываются с буфером данных
+   * кадра при компоновке. Раскладка блока (std140):
+   * - mat4 view_projection - матрица вида-проекции камеры
+   * - vec4 time            - время от запуска (x) и длительность кадра (y)
+   * в секундах
+   * - vec4 viewport        - размер области отрисовки в пикселях (xy) и
+   * обратные ему величины (zw)
+   * \sa res/shaders/test_shader.vert
+   */
+  static constexpr const char* frame_block_name{"frame_data"};
+  /*!
+   * \brief Точка привязки буфера данных кадра
+   */
+  static constexpr unsigned int frame_block_binding{0};
+  /*!
+   * \brief Обновление данных кадра
+   * Загружает в буфер данных кадра матрицу камеры, время и размер области
+   * отрисовки
+   * \param time    время от запуска в секундах
+   * \param delta   длительность предыдущего кадра в секундах
+   * \note Вызывается классом core::engine один раз за кадр перед отрисовкой
+   * \note В режиме потока рендера данные загружаются потоком рендера вместе
+   * с записанным кадром
+   */
+  static void update_frame_data(float time, float delta);
+  /*!
+   * \brief Время кадра в секундах от запуска
+   * Значение frame.time.x, которое получат шейдеры текущего кадра
+   */
+  static float get_time() { return frame_data.time.x; }
+
+  /*!
+   * \brief Отправка спрайта на отрисовку
+   * Добавляет спрайт в пакет, если он попадает в видимую область камеры.
+   * Если пакетная отрисовка выключена, пакет сбрасывается сразу после
+   * добавления спрайта
+   * \param program     шейдерная программа спрайта
+   * \param texture     текстура спрайта
+   * \param settings    свойства отрисовки
+   * \param frame       описатель области текстуры
+   * \sa render::sprite_batch
+   */
+  static void submit(shader_program& program, const texture2D& texture,
+                     const render_settings& settings,
+                     const frame_descriptor& frame);
+  /*!
+   * \brief Отрисовка всех накопленных спрайтов
+   * \note В режиме потока рендера не выполняет gl-вызовов: накопленные
+   * элементы отрисовываются потоком рендера в конце кадра
+   */
+  static void flush();
+  /*!
+   * \brief Завершение кадра
+   * Отрисовывает накопленные спрайты и переключает потоковые буферы рендера
+   * на следующий сегмент. В режиме потока рендера передает записанный кадр
+   * потоку рендера
+   * \note Вызывается классом core::engine в конце каждого кадра
+   */
+  static void end_frame();
+
+  /*!
+   * \brief Запуск потока рендера
+   * После запуска игровой поток только записывает кадры: список отрисовки,
+   * данные кадра, область отрисовки и цвет очистки передаются потоку рендера
+   * в renderer::end_frame(), который очищает back-буфер, отрисовывает кадр и
+   * переключает буферы
+   * \param attach      делает gl-контекст текущим для потока рендера
+   * \param present     переключает back-буфер окна
+   * \param detach      освобождает gl-контекст перед завершением потока
+   * \note Перед запуском игровой поток должен освободить gl-контекст. Пока
+   * поток работает, игровой поток не должен создавать и удалять gl-объекты
+   * \note Статистика кадра отстает на один кадр от записи
+   * \sa render::render_thread
+   */
+  static void start_thread(std::function<void()> attach,
+                           std::function<void()> present,
+                           std::function<void()> detach);
+  /*!
+   * \brief Остановка потока рендера
+   * Дожидается отрисовки последнего записанного кадра
+   * \note После остановки gl-контекст необходимо сделать текущим для
+   * игрового потока
+   */
+  static void stop_thread();
+  /*!
+   * \brief Состояние потока рендера
+   * \return true - кадры отрисовываются потоком рендера
+   */
+  static bool is_threaded() { return thread != nullptr; }
+  /*!
+   * \brief Отправка инстансной отрисовки общего квада
+   * \param program     инстансная шейдерная программа
+   * \param texture     текстура экземпляров
+   * \param texture_uniform   поле s_texture программы, найденное заранее
+   * \param layer       слой сортировки в списке отрисовки
+   * \param blend       класс смешивания экземпляров
+   * \param data        данные экземпляров, копируются в список отрисовки
+   * \param count       количество экземпляров
+   * \note Экземпляры вне видимой области камеры не копируются
+   */
+  static void submit_instances(shader_program& program,
+                               const texture2D& texture,
+                               const uniform<int>& texture_uniform, int layer,
+                               blend_mode blend,
+                               const sprite_quad::instance* data,
+                               unsigned int count);
+  /*!
+   * \brief Отправка произвольной команды отрисовки
+   * Команда выполняется при сбросе пакета в порядке сортировки по классу
+   * смешивания и слою
+   * \param layer       слой сортировки в списке отрисовки
+   * \param blend       класс смешивания, его состояние устанавливается перед
+   * выполнением команды
+   * \param command     команда отрисовки
+   */
+  static void submit_command(int layer, blend_mode blend,
+                             std::function<void()> command);
+  /*!
+   * \brief Отправка списка команд потока
+   * Список объединяется со списком отрисовки кадра при сбросе пакета. Списки
+   * объединяются в порядке возрастания номеров после элементов, отправленных
+   * напрямую
+   * \param list    заполненный список команд
+   * \note Вызывается в потоке отправки. Список должен существовать до конца
+   * кадра
+   * \sa render::command_list
+   */
+  static void submit_list(command_list& list);
+  /*!
+   * \brief Общий единичный квад для инстансной отрисовки спрайтов
+   * \sa render::sprite_quad
+   */
+  static sprite_quad& get_quad() { return *quad; }
   /*!
    * \brief Задать диапазон для отрисовки
    * Задает диапазон, в границах которого будет расчитываться отрисовка
@@ -51,10 +259,280 @@ class renderer
    * \brief Очистка back-буфера
    * Очищает буфер, который будет заполняться, цветом, указанным в
    * renderer::clear_color(float r, float g, float b, float a)
+   * \note Включает запись глубины, иначе буфер глубины не очищается
    */
   static void clear();
 
+  /*!
+   * \brief Создание внеэкранной цели отрисовки
+   * Создает буфер кадра, который заменяет back-буфер окна: все кадры
+   * отрисовываются в него, а renderer::request_capture() читает пиксели из
+   * него. Используется в режиме без отображения окна
+   * \param width   ширина в пикселях
+   * \param height  высота в пикселях
+   * \return false - буфер кадра не удалось создать, отрисовка продолжается в
+   * back-буфер окна
+   * \sa core::window_properties::headless
+   */
+  static bool create_offscreen_target(int width, int height);
+  /*!
+   * \brief Буфер кадра, заменяющий back-буфер окна
+   * \return 0 - отрисовка выполняется в back-буфер окна
+   */
+  static GLuint get_default_framebuffer() { return default_framebuffer; }
+  /*!
+   * \brief Запрос снимка кадра
+   * Пиксели области отрисовки текущего кадра читаются после отрисовки всех
+   * накопленных спрайтов, до переключения буферов
+   * \note В режиме потока рендера снимок становится доступен после
+   * отрисовки кадра потоком рендера
+   * \sa renderer::take_capture
+   */
+  static void request_capture();
+  /*!
+   * \brief Получение последнего снимка кадра
+   * \param rgba    пиксели снимка, по 4 байта rgba на пиксель, строки
+   * сверху вниз
+   * \param width   ширина снимка
+   * \param height  высота снимка
+   * \return false - нового снимка нет, параметры не изменяются
+   */
+  static bool take_capture(std::vector<unsigned char>& rgba, int& width,
+                           int& height);
+
+  /*!
+   * \brief Получение цели отрисовки из пула
+   * \param width   ширина в пикселях
+   * \param height  высота в пикселях
+   * \param depth   true - цель с буфером глубины
+   * \return nullptr - буфер кадра не удалось создать
+   * \note Вызывается в потоке, владеющем gl-контекстом, то есть в командах
+   * отрисовки
+   * \sa render::render_target_pool
+   */
+  static std::unique_ptr<framebuffer> acquire_target(int width, int height,
+                                                     bool depth = true);
+  /*!
+   * \brief Возврат цели отрисовки в пул
+   * \note Может вызываться из любого потока
+   */
+  static void release_target(std::unique_ptr<framebuffer> target);
+  /*!
+   * \brief Отрисовка списка в цель отрисовки
+   * Очищает цель прозрачным цветом, отрисовывает отсортированный список с
+   * заданной матрицей вида-проекции и восстанавливает буфер кадра, область
+   * отрисовки и данные кадра текущего прохода
+   * \param target            цель отрисовки
+   * \param view_projection   матрица вида-проекции прохода
+   * \param items             элементы прохода, очищаются после отрисовки
+   * \note Вызывается в потоке, владеющем gl-контекстом, в том числе из
+   * команды отрисовки кадра
+   */
+  static void draw_to_target(framebuffer& target,
+                             const glm::mat4x4& view_projection,
+                             draw_list& items);
+  /*!
+   * \brief Установка цепочки постобработки
+   * Кадр отрисовывается в цель отрисовки размером с область отрисовки, после
+   * чего проходы выполняются по порядку, а последний записывает результат в
+   * кадр окна. Пустая цепочка отключает постобработку
+   * \param passes      проходы цепочки
+   * \param profile     true - после каждого прохода ожидается его
+   * завершение (glFinish), и время прохода в frame_stats включает работу
+   * видеокарты. Замедляет кадр, используется для измерений
+   * \note Цепочка применяется, начиная со следующего кадра
+   * \sa render::post_process_pass
+   */
+  static void set_post_process(std::vector<post_process_pass> passes,
+                               bool profile = false);
+  /*!
+   * \brief Динамическое разрешение
+   * Кадр отрисовывается в цель отрисовки, размер которой равен области
+   * отрисовки, умноженной на масштаб разрешения, и растягивается до области
+   * отрисовки окна. Масштаб подбирается по длительности кадров,
+   * переданных в renderer::update_frame_data
+   * \param enabled     true - включить динамическое разрешение
+   * \param budget_ms   бюджет кадра в миллисекундах
+   * \param min_scale   наименьший масштаб разрешения
+   * \sa render::resolution_controller
+   * \sa core::window_properties::dynamic_resolution
+   */
+  static void set_dynamic_resolution(bool enabled, float budget_ms = 16.6f,
+                                     float min_scale = 0.5f);
+  /*!
+   * \brief Текущий масштаб разрешения кадра
+   * \return 1 - динамическое разрешение выключено или кадр не уменьшен
+   */
+  static float get_resolution_scale() { return resolution_scale; }
+
+  /*!
+   * \name Кэш состояния контекста
+   * Рендер хранит текущее состояние gl-контекста и пропускает вызовы, не
+   * изменяющие его. Все классы модуля render меняют состояние контекста только
+   * через эти функции.
+   * \note Кэш привязки буфера индексов сбрасывается при смене vao, так как
+   * эта привязка является частью состояния vao
+   */
+  ///@{
+  static void use_program(GLuint id);
+  static void bind_vertex_array(GLuint id);
+  static void bind_buffer(GLenum target, GLuint id);
+  static void bind_buffer_base(GLenum target, unsigned int index, GLuint id);
+  static void active_texture(unsigned int unit);
+  static void bind_texture(GLuint id);
+  static void set_depth_test(bool enabled);
+  static void set_depth_write(bool enabled);
+  static void set_depth_func(GLenum func);
+  static void set_blend(bool enabled);
+  static void set_blend_func(GLenum src, GLenum dst);
+  /*!
+   * \brief Состояние класса смешивания
+   * - opaque, alpha_test - смешивание выключено, глубина записывается
+   * - translucent - смешивание предумноженного цвета (GL_ONE,
+   * GL_ONE_MINUS_SRC_ALPHA), глубина проверяется, но не записывается
+   */
+  static void set_blend_mode(blend_mode mode);
+  static void bind_framebuffer(GLuint id);
+  static GLuint get_bound_framebuffer() { return state.framebuffer; }
+  ///@}
+
+  /*!
+   * \name Удаление gl-объектов
+   * Сбрасывает кэшированные привязки удаляемого объекта. Вызывается
+   * непосредственно перед удалением объекта.
+   */
+  ///@{
+  static void forget_program(GLuint id);
+  static void forget_vertex_array(GLuint id);
+  static void forget_buffer(GLuint id);
+  static void forget_texture(GLuint id);
+  static void forget_framebuffer(GLuint id);
+  ///@}
+
+  /*!
+   * \brief Начало нового кадра
+   * Сохраняет статистику завершенного кадра и обнуляет счетчики
+   * \note Вызывается классом core::engine в начале каждого кадра
+   */
+  static void begin_frame();
+  /*!
+   * \brief Статистика последнего завершенного кадра
+   */
+  static const frame_stats& get_stats() { return last_stats; }
+  /*!
+   * \brief Статистика текущего кадра
+   * \note Счетчики принадлежат потоку: в режиме потока рендера игровой поток
+   * считает спрайты, а поток рендера - gl-вызовы
+   */
+  static frame_stats& current_stats() { return stats; }
+
   renderer() = delete;
+
+ private:
+  /*!
+   * \brief Кэшированное состояние gl-контекста
+   * \note Начальные значения соответствуют состоянию нового контекста
+   */
+  struct state_cache
+  {
+    static constexpr GLuint unknown{~0u};
+    static constexpr unsigned int texture_units{32};
+
+    GLuint program{0};
+    GLuint vertex_array{0};
+    GLuint array_buffer{0};
+    GLuint element_buffer{0};
+    GLuint uniform_buffer{0};
+    unsigned int texture_unit{0};
+    std::array<GLuint, texture_units> textures{};
+    bool depth_test{false};
+    bool depth_write{true};
+    GLenum depth_func{GL_LESS};
+    bool blend{false};
+    GLenum blend_src{GL_ONE};
+    GLenum blend_dst{GL_ZERO};
+    GLuint framebuffer{0};
+  };
+
+  /*!
+   * \brief Учет gl-вызова смены состояния
+   * \return true - состояние изменилось и вызов необходимо выполнить
+   */
+  static bool changed(bool differs);
+
+  /*!
+   * \brief Синхронизация данных кадра с камерой
+   * Повторно загружает буфер данных кадра, если камера изменилась после
+   * последней загрузки
+   */
+  static void sync_frame_data();
+  static void upload_frame_data();
+  /*!
+   * \brief Объединение отправленных списков команд со списком кадра
+   */
+  static void merge_lists();
+  /*!
+   * \brief Отрисовка записанного кадра потоком рендера
+   */
+  static void execute(frame_packet& packet);
+  /*!
+   * \brief Чтение пикселей области отрисовки в снимок кадра
+   */
+  static void capture(const glm::ivec4& area);
+
+  static state_cache state;
+  static frame_uniforms frame_data;
+  inline static thread_local frame_stats stats{};
+  inline static frame_stats last_stats{};
+
+  inline static camera2D camera{};
+  inline static glm::ivec4 viewport{0};
+  inline static glm::vec4 clear_rgba{0};
+  inline static std::vector<sprite_quad::instance> visible_instances{};
+  inline static std::vector<command_list*> submitted_lists{};
+
+  static std::unique_ptr<sprite_batch> batch;
+  static std::unique_ptr<sprite_quad> quad;
+  static std::unique_ptr<uniform_buffer> frame_buffer;
+  static std::unique_ptr<render_thread> thread;
+  static std::function<void()> present;
+  static frame_packet recording;  ///< пакет записываемого кадра
+  static std::unique_ptr<framebuffer> offscreen;
+  /*!
+   * \brief Пакет проходов в цели отрисовки
+   * \note Отдельный от пакета кадра, так как проход выполняется командой
+   * во время отрисовки пакета кадра
+   */
+  static std::unique_ptr<sprite_batch> target_batch;
+  static std::unique_ptr<render_target_pool> targets;
+  static std::unique_ptr<post_processor> post;
+  inline static std::vector<post_process_pass> post_passes{};
+  inline static bool post_profile{false};
+  static std::unique_ptr<resolution_controller> resolution;
+  inline static float resolution_scale{1.f};
+  /// \name Состояние прохода кадра в потоке, владеющем gl-контекстом
+  ///@{
+  inline static frame_uniforms applied_frame{};
+  inline static glm::ivec4 applied_viewport{0};
+  ///@}
+  inline static GLuint default_framebuffer{0};
+  inline static bool batching{true};
+
+  inline static bool capture_requested{false};
+  /*!
+   * \brief Последний снимок кадра
+   * \note Записывается потоком, владеющим gl-контекстом, читается игровым
+   * потоком
+   */
+  struct frame_capture
+  {
+    std::mutex mutex{};
+    std::vector<unsigned char> pixels{};
+    int width{0};
+    int height{0};
+    bool ready{false};
+  };
+  static frame_capture captured;
 };
 
 }  // namespace render
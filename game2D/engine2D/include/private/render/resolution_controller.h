@@ -0,0 +1,61 @@
+#pragma once
+#include <array>
+namespace render
+{
+/*!
+ * \brief Регулятор динамического разрешения
+ * Изменяет масштаб разрешения кадра по средней длительности последних
+ * кадров относительно бюджета кадра. Масштаб меняется дискретными шагами,
+ * поэтому цели отрисовки кадра принимают небольшое число размеров и берутся
+ * из пула без повторного создания.
+ * \note Гистерезис:
+ * - после каждого изменения история кадров сбрасывается и регулятор
+ * ожидает заполнения истории
+ * - масштаб уменьшается, если средняя длительность превышает бюджет более
+ * чем на over_budget
+ * - масштаб увеличивается при запасе under_budget или, при вертикальной
+ * синхронизации, когда длительность не опускается ниже бюджета, после
+ * probe_delay кадров в пределах бюджета. Неудачная проба удваивает задержку
+ * следующей
+ */
+class resolution_controller
+{
+ public:
+  static constexpr float scale_step{0.125f};
+  static constexpr float over_budget{1.1f};
+  static constexpr float under_budget{0.8f};
+  static constexpr unsigned int history_size{16};
+  static constexpr unsigned int min_probe_delay{120};
+  static constexpr unsigned int max_probe_delay{1920};
+
+  /*!
+   * \brief Настройка регулятора
+   * \param budget_ms   бюджет кадра в миллисекундах
+   * \param min_scale   наименьший масштаб разрешения
+   * \note Сбрасывает масштаб до 1
+   */
+  void configure(float budget_ms, float min_scale);
+
+  /*!
+   * \brief Учет длительности кадра
+   * \param frame_ms    длительность завершенного кадра в миллисекундах
+   * \return true - масштаб изменился
+   */
+  bool update(float frame_ms);
+
+  float get_scale() const { return scale; }
+
+ private:
+  void change_scale(float new_scale);
+
+  float budget{16.6f};
+  float min_scale{0.5f};
+  float scale{1.f};
+
+  std::array<float, history_size> history{};
+  unsigned int frames{0};          ///< заполненные элементы истории
+  unsigned int stable_frames{0};   ///< кадры в пределах бюджета подряд
+  unsigned int probe_delay{min_probe_delay};
+  bool probing{false};  ///< последнее изменение - проба увеличения
+};
+}  // namespace render
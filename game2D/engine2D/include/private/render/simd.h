@@ -0,0 +1,196 @@
+#pragma once
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE2D_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ENGINE2D_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#include <limits>
+namespace render::simd
+{
+/*!
+ * \brief Вектор из четырех float
+ * Минимальная обертка над SSE2/NEON регистром, используемая
+ * вычислительными ядрами рендера. При отсутствии поддерживаемого набора
+ * инструкций используется скалярная реализация.
+ * \note Сравнения возвращают маску: все биты элемента установлены, если
+ * условие истинно
+ */
+struct float4
+{
+#if defined(ENGINE2D_SIMD_SSE2)
+  __m128 v;
+#elif defined(ENGINE2D_SIMD_NEON)
+  float32x4_t v;
+#else
+  float v[4];
+#endif
+};
+
+/*!
+ * \brief Название используемого набора инструкций
+ */
+inline const char* instruction_set()
+{
+#if defined(ENGINE2D_SIMD_SSE2)
+  return "SSE2";
+#elif defined(ENGINE2D_SIMD_NEON)
+  return "NEON";
+#else
+  return "scalar";
+#endif
+}
+
+#if defined(ENGINE2D_SIMD_SSE2)
+
+inline float4 load(const float* data) { return {_mm_loadu_ps(data)}; }
+inline void store(float* data, float4 a) { _mm_storeu_ps(data, a.v); }
+inline float4 set(float value) { return {_mm_set1_ps(value)}; }
+inline float4 operator+(float4 a, float4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline float4 operator-(float4 a, float4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline float4 operator*(float4 a, float4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline float4 operator-(float4 a)
+{
+  return {_mm_xor_ps(a.v, _mm_set1_ps(-0.f))};
+}
+inline float4 operator<=(float4 a, float4 b)
+{
+  return {_mm_cmple_ps(a.v, b.v)};
+}
+inline float4 operator>=(float4 a, float4 b)
+{
+  return {_mm_cmpge_ps(a.v, b.v)};
+}
+inline float4 operator|(float4 a, float4 b) { return {_mm_or_ps(a.v, b.v)}; }
+/*!
+ * \brief Поэлементный выбор: mask ? a : b
+ */
+inline float4 select(float4 mask, float4 a, float4 b)
+{
+  return {_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v))};
+}
+/*!
+ * \brief Смена знака элементов, для которых установлена маска
+ */
+inline float4 negate_if(float4 mask, float4 a)
+{
+  return {_mm_xor_ps(a.v, _mm_and_ps(mask.v, _mm_set1_ps(-0.f)))};
+}
+
+#elif defined(ENGINE2D_SIMD_NEON)
+
+inline float4 load(const float* data) { return {vld1q_f32(data)}; }
+inline void store(float* data, float4 a) { vst1q_f32(data, a.v); }
+inline float4 set(float value) { return {vdupq_n_f32(value)}; }
+inline float4 operator+(float4 a, float4 b) { return {vaddq_f32(a.v, b.v)}; }
+inline float4 operator-(float4 a, float4 b) { return {vsubq_f32(a.v, b.v)}; }
+inline float4 operator*(float4 a, float4 b) { return {vmulq_f32(a.v, b.v)}; }
+inline float4 operator-(float4 a) { return {vnegq_f32(a.v)}; }
+inline float4 operator<=(float4 a, float4 b)
+{
+  return {vreinterpretq_f32_u32(vcleq_f32(a.v, b.v))};
+}
+inline float4 operator>=(float4 a, float4 b)
+{
+  return {vreinterpretq_f32_u32(vcgeq_f32(a.v, b.v))};
+}
+inline float4 operator|(float4 a, float4 b)
+{
+  return {vreinterpretq_f32_u32(
+      vorrq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v)))};
+}
+inline float4 select(float4 mask, float4 a, float4 b)
+{
+  return {vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v)};
+}
+inline float4 negate_if(float4 mask, float4 a)
+{
+  return {vreinterpretq_f32_u32(
+      veorq_u32(vreinterpretq_u32_f32(a.v),
+                vandq_u32(vreinterpretq_u32_f32(mask.v),
+                          vdupq_n_u32(0x80000000u))))};
+}
+
+#else
+
+inline float4 load(const float* data)
+{
+  return {{data[0], data[1], data[2], data[3]}};
+}
+inline void store(float* data, float4 a)
+{
+  for (int it{0}; it < 4; it++) data[it] = a.v[it];
+}
+inline float4 set(float value) { return {{value, value, value, value}}; }
+
+namespace detail
+{
+template <typename operation>
+inline float4 apply(float4 a, float4 b, operation op)
+{
+  float4 result{};
+  for (int it{0}; it < 4; it++) result.v[it] = op(a.v[it], b.v[it]);
+  return result;
+}
+inline float mask_value(bool value)
+{
+  // any non-zero value is a set mask
+  return value ? std::numeric_limits<float>::quiet_NaN() : 0.f;
+}
+}  // namespace detail
+
+inline float4 operator+(float4 a, float4 b)
+{
+  return detail::apply(a, b, [](float x, float y) { return x + y; });
+}
+inline float4 operator-(float4 a, float4 b)
+{
+  return detail::apply(a, b, [](float x, float y) { return x - y; });
+}
+inline float4 operator*(float4 a, float4 b)
+{
+  return detail::apply(a, b, [](float x, float y) { return x * y; });
+}
+inline float4 operator-(float4 a) { return set(0.f) - a; }
+inline float4 operator<=(float4 a, float4 b)
+{
+  return detail::apply(
+      a, b, [](float x, float y) { return detail::mask_value(x <= y); });
+}
+inline float4 operator>=(float4 a, float4 b)
+{
+  return detail::apply(
+      a, b, [](float x, float y) { return detail::mask_value(x >= y); });
+}
+inline float4 operator|(float4 a, float4 b)
+{
+  return detail::apply(a, b, [](float x, float y) {
+    return detail::mask_value(x != 0.f || y != 0.f);
+  });
+}
+inline float4 select(float4 mask, float4 a, float4 b)
+{
+  float4 result{};
+  for (int it{0}; it < 4; it++)
+    result.v[it] = mask.v[it] != 0.f ? a.v[it] : b.v[it];
+  return result;
+}
+inline float4 negate_if(float4 mask, float4 a)
+{
+  return select(mask, -a, a);
+}
+
+#endif
+
+/*!
+ * \brief Округление к ближайшему целому
+ * \note Точно для |a| < 2^22
+ */
+inline float4 round(float4 a)
+{
+  const float4 magic{set(12582912.f)};  // 1.5 * 2^23
+  return (a + magic) - magic;
+}
+}  // namespace render::simd
@@ -0,0 +1,184 @@
+#pragma once
+#include <render/draw_list.h>
+#include <render/frame_structures.h>
+#include <render/index_buffer.h>
+#include <render/shader_program.h>
+#include <render/sprite_transform.h>
+#include <render/vertex_array.h>
+#include <render/vertex_buffer.h>
+#include <render/vertex_buffer_descriptor.h>
+#include <glm/vec2.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+namespace render
+{
+class texture2D;
+
+/*!
+ * \brief Пакетный рендер спрайтов
+ * Накапливает элементы, отправленные на отрисовку в течение кадра, в списке
+ * отрисовки. При сбросе список сортируется по ключам, вершины спрайтов
+ * загружаются в общий вершинный буфер одним вызовом, и спрайты
+ * отрисовываются минимальным количеством вызовов glDrawElements: по одному
+ * вызову на каждую серию спрайтов с одинаковыми шейдерной программой,
+ * текстурой, слоем и классом смешивания.
+ * \note Перед каждой серией рендер устанавливает состояние смешивания и
+ * записи глубины ее класса смешивания
+ * \sa render::renderer::set_blend_mode
+ * \note Вершины спрайтов преобразуются на стороне CPU ядром
+ * render::sprite_transform, поэтому uniform-поле s_model при отрисовке серии
+ * принимает единичную матрицу
+ * \note Матрица вида-проекции камеры передается в шейдеры uniform-блоком
+ * данных кадра, который обновляется перед сбросом пакета
+ * \note Вершины загружаются в кольцевой потоковый буфер, поэтому загрузка
+ * не ожидает завершения отрисовки предыдущих кадров
+ * \note Программы и текстуры, переданные в пакет, должны существовать до
+ * вызова sprite_batch::flush()
+ * \sa render::draw_list
+ */
+class sprite_batch
+{
+ public:
+  /*!
+   * \brief Вершина пакета
+   */
+  struct vertex
+  {
+    glm::vec2 position;  ///< положение вершины
+    glm::vec2 uv;        ///< текстурная координата вершины
+  };
+
+  sprite_batch();
+
+  /*!
+   * \brief Добавление спрайта в пакет
+   * \param program     шейдерная программа спрайта
+   * \param texture     текстура спрайта
+   * \param settings    свойства отрисовки
+   * \param frame       описатель области текстуры
+   */
+  void push(shader_program& program, const texture2D& texture,
+            const render_settings& settings, const frame_descriptor& frame);
+
+  /*!
+   * \brief Добавление инстансной отрисовки общего квада
+   * \param program     инстансная шейдерная программа
+   * \param texture     текстура экземпляров
+   * \param texture_uniform   поле s_texture программы
+   * \param layer       слой сортировки
+   * \param blend       класс смешивания
+   * \param data        данные экземпляров, копируются в пакет
+   * \param count       количество экземпляров
+   */
+  void push_instances(shader_program& program, const texture2D& texture,
+                      const uniform<int>& texture_uniform, int layer,
+                      blend_mode blend,
+                      const sprite_quad::instance* data, unsigned int count);
+
+  /*!
+   * \brief Добавление произвольной команды отрисовки
+   * \param layer       слой сортировки
+   * \param blend       класс смешивания, устанавливается перед выполнением
+   * \param command     команда, выполняемая при сбросе пакета
+   */
+  void push_command(int layer, blend_mode blend,
+                    std::function<void()> command);
+
+  /*!
+   * \brief Перенос элементов списка отрисовки в пакет
+   * \param items   список, очищается после переноса
+   * \sa render::draw_list::append
+   */
+  void append(draw_list& items) { list.append(items); }
+
+  /*!
+   * \brief Отрисовка накопленных элементов
+   * Сортирует список отрисовки, загружает вершины спрайтов в буфер и
+   * отрисовывает элементы по порядку, после чего очищает пакет
+   */
+  void flush();
+  /*!
+   * \brief Отрисовка списка отрисовки
+   * Выполняет сброс для переданного списка вместо накопленного в пакете
+   * \param items   список отрисовки, очищается после отрисовки
+   * \note Используется потоком рендера для отрисовки записанных кадров
+   */
+  void execute(draw_list& items);
+
+  /*!
+   * \brief Обмен накопленного списка отрисовки
+   * \param other   список, который станет списком пакета
+   * \note Используется рендером для передачи записанного кадра потоку
+   * рендера
+   */
+  void swap_list(draw_list& other) { std::swap(list, other); }
+
+  /*!
+   * \brief Завершение кадра
+   * Переключает потоковый вершинный буфер на следующий сегмент
+   * \note Вызывается рендером в конце каждого кадра
+   */
+  void end_frame() { vbo.end_frame(); }
+
+  /*!
+   * \brief Возвращает количество элементов, ожидающих отрисовки
+   */
+  size_t get_size() const { return list.size(); }
+
+  sprite_batch(sprite_batch&) = delete;
+  sprite_batch& operator=(sprite_batch&) = delete;
+
+ private:
+  /*!
+   * \brief Серия элементов с общим состоянием отрисовки
+   */
+  struct run
+  {
+    draw_list::item_type type;
+    shader_program* program;
+    const texture2D* texture;
+    int layer;
+    blend_mode blend;
+    unsigned int first;  ///< индекс первого спрайта серии или номер элемента
+    unsigned int count;  ///< количество спрайтов в серии
+  };
+
+  /*!
+   * \brief Дескрипторы uniform-полей программы спрайтов
+   */
+  struct program_uniforms
+  {
+    uniform<int> texture{};
+    uniform<glm::mat4x4> model{};
+    uniform<int> layer{};
+  };
+
+  /*!
+   * \brief Активация программы серии
+   * Устанавливает текстурный блок. Поля программы ищутся один раз и
+   * сохраняются между кадрами
+   * \return Дескрипторы полей программы
+   */
+  const program_uniforms& use_program(shader_program& program);
+  void reserve_indices(size_t sprites);
+  void draw_run(const draw_list& items, const run& current);
+
+  static constexpr unsigned int vertices_per_sprite{4};
+  static constexpr unsigned int indices_per_sprite{6};
+
+  vertex_array vao;
+  vertex_buffer vbo{buffer_usage::stream_draw};
+  vertex_buffer_descriptor descriptor{};
+  index_buffer ibo;
+  size_t index_capacity{0};  ///< количество спрайтов в буфере индексов
+
+  draw_list list{};
+  std::vector<vertex> vertices{};
+  sprite_transform_input transforms{};
+  std::vector<run> runs{};
+  std::unordered_map<const shader_program*, program_uniforms> uniforms{};
+  const shader_program* last_program{nullptr};
+  const program_uniforms* last_uniforms{nullptr};
+};
+}  // namespace render
@@ -0,0 +1,15 @@
+#pragma once
+#include <render/shader_program.h>
+#include <render/sprite_instances.h>
+#include <render/sprite_quad.h>
+#include <vector>
+namespace render
+{
+struct sprite_instances::instances_impl
+{
+  std::vector<sprite_quad::instance> instances{};
+  int min_layer{0};  ///< слой сортировки набора
+  blend_mode blend{blend_mode::translucent};
+  uniform<int> texture_uniform{};
+};
+}  // namespace render
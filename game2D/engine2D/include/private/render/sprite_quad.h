@@ -0,0 +1,69 @@
+#pragma once
+#include <render/index_buffer.h>
+#include <render/vertex_array.h>
+#include <render/vertex_buffer.h>
+#include <render/vertex_buffer_descriptor.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+namespace render
+{
+class shader_program;
+
+/*!
+ * \brief Общий единичный квад
+ * Геометрия единичного квада [0;1], принадлежащая рендеру и используемая
+ * всеми инстансными отрисовками спрайтов. Данные экземпляров загружаются в
+ * общий кольцевой буфер экземпляров перед каждой отрисовкой, поэтому создание
+ * наборов спрайтов не требует создания gl-объектов, а загрузка не ожидает
+ * завершения отрисовки предыдущих кадров.
+ * \note Атрибуты вершин:
+ * - location 0 - vec2, вершина единичного квада
+ * - location 1 - vec4, положение (xy) и размер (zw) экземпляра
+ * - location 2 - vec2, угол поворота (x) и слой (y) экземпляра
+ * - location 3 - vec4, область текстуры экземпляра
+ * - location 4 - vec4, цвет экземпляра
+ */
+class sprite_quad
+{
+ public:
+  /*!
+   * \brief Данные одного экземпляра в буфере экземпляров
+   */
+  struct instance
+  {
+    glm::vec4 position_size;   ///< положение (xy) и размер (zw)
+    glm::vec2 rotation_layer;  ///< угол поворота (x) и слой (y)
+    glm::vec4 uv;              ///< область текстуры
+    glm::vec4 color;           ///< цвет, умножается на цвет текстуры
+  };
+
+  sprite_quad();
+
+  /*!
+   * \brief Инстансная отрисовка квада
+   * \param program     используемая шейдерная программа
+   * \param instances   указатель на данные экземпляров
+   * \param count       количество экземпляров
+   * \note Данные instances могут быть удалены после вызова
+   */
+  void draw(const shader_program& program, const instance* instances,
+            unsigned int count);
+
+  /*!
+   * \brief Завершение кадра
+   * Переключает буфер экземпляров на следующий сегмент
+   * \note Вызывается рендером в конце каждого кадра
+   */
+  void end_frame() { instance_vbo.end_frame(); }
+
+  sprite_quad(sprite_quad&) = delete;
+  sprite_quad& operator=(sprite_quad&) = delete;
+
+ private:
+  vertex_array vao;
+  vertex_buffer quad_vbo;
+  vertex_buffer instance_vbo{buffer_usage::stream_draw};
+  vertex_buffer_descriptor instance_descriptor{};
+  index_buffer vebo;
+};
+}  // namespace render
@@ -0,0 +1,93 @@
+#pragma once
+#include <render/index_buffer.h>
+#include <render/shader_program.h>
+#include <render/sprite_quad.h>
+#include <render/sprite_scene.h>
+#include <render/vertex_array.h>
+#include <render/vertex_buffer.h>
+#include <render/vertex_buffer_descriptor.h>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+namespace render
+{
+struct sprite_scene::scene_impl
+{
+  /*!
+   * \brief gl-объекты сцены
+   * \note Создаются и используются потоком, выполняющим команды отрисовки
+   */
+  struct gpu_state
+  {
+    gpu_state();
+
+    gpu_state(gpu_state&) = delete;
+    gpu_state& operator=(gpu_state&) = delete;
+
+    vertex_array vao{};
+    vertex_buffer quad_vbo{};
+    vertex_buffer instance_vbo{buffer_usage::dynamic_draw};
+    index_buffer vebo{};
+    unsigned int capacity{0};  ///< емкость буфера экземпляров
+  };
+
+  /*!
+   * \brief Диапазон изменившихся спрайтов, ожидающий загрузки
+   */
+  struct range_upload
+  {
+    unsigned int first;
+    std::vector<sprite_quad::instance> instances;
+  };
+
+  /*!
+   * \brief Наибольший промежуток между изменившимися спрайтами, которые
+   * загружаются одним диапазоном
+   */
+  static constexpr unsigned int merge_gap{16};
+  /// номер удаленного спрайта в dense_index
+  static constexpr unsigned int no_sprite{~0u};
+
+  void mark_dirty(unsigned int index);
+  /*!
+   * \brief Сборка диапазонов изменившихся спрайтов
+   * Если спрайты не помещаются в буфер, емкость буфера увеличивается, и
+   * загружаются все спрайты
+   */
+  std::vector<range_upload> collect_uploads();
+  /*!
+   * \brief Загрузка диапазонов и отрисовка
+   * \note Выполняется командой отрисовки
+   */
+  void draw(shader_program& program, texture2D& atlas, unsigned int count,
+            unsigned int capacity, const std::vector<range_upload>& uploads);
+
+  /// \name Спрайты, плотные массивы
+  ///@{
+  std::vector<sprite_quad::instance> instances{};
+  std::vector<render_settings> settings{};
+  std::vector<handle> owner{};  ///< номер спрайта элемента
+  std::vector<std::uint8_t> dirty_flags{};
+  ///@}
+
+  std::vector<unsigned int> dense_index{};  ///< номер спрайта - элемент
+  std::vector<handle> free_handles{};
+  std::vector<unsigned int> dirty{};  ///< изменившиеся элементы
+
+  unsigned int capacity{0};  ///< емкость буфера, запрошенная игровым потоком
+  int min_layer{0};
+  blend_mode blend{blend_mode::translucent};
+
+  std::unique_ptr<gpu_state> gpu{};
+  uniform<int> texture{};
+  bool uniforms_resolved{false};
+
+  unsigned int index_of(handle sprite) const
+  {
+    assert(sprite < dense_index.size() && dense_index[sprite] != no_sprite &&
+           "unknown sprite handle");
+    return dense_index[sprite];
+  }
+};
+}  // namespace render
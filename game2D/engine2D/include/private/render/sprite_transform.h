@@ -0,0 +1,62 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <cstddef>
+#include <vector>
+namespace render
+{
+/*!
+ * \brief Свойства отрисовки спрайтов в виде структуры массивов
+ * Входные данные ядра преобразования sprite_transform::transform_quads.
+ * Хранение каждого свойства в отдельном массиве позволяет обрабатывать
+ * несколько спрайтов одной SIMD-инструкцией.
+ */
+struct sprite_transform_input
+{
+  std::vector<float> x;         ///< положение по оси абсцисс
+  std::vector<float> y;         ///< положение по оси ординат
+  std::vector<float> width;     ///< ширина
+  std::vector<float> height;    ///< высота
+  std::vector<float> rotation;  ///< угол поворота в градусах
+
+  void push_back(const render_settings& settings);
+  void clear();
+  size_t size() const { return x.size(); }
+};
+
+/*!
+ * \brief Ядро преобразования спрайтов
+ * Вычисляет положения углов квадов спрайтов в мировых координатах: поворот
+ * вокруг центра спрайта и перенос в его положение. Результат совпадает с
+ * преобразованием единичного квада матрицей
+ * translate(position + size / 2) * rotate(rotation) * translate(-size / 2) *
+ * scale(size).
+ * Спрайты обрабатываются по четыре с использованием SSE2 или NEON, при их
+ * отсутствии используется скалярная реализация. Синус и косинус вычисляются
+ * полиномиальным приближением с погрешностью около 1e-6.
+ * \sa render::simd::float4
+ */
+class sprite_transform
+{
+ public:
+  /*!
+   * \brief Преобразование спрайтов в углы квадов
+   * \param input       свойства спрайтов
+   * \param corners     указатель на x-координату первого угла первого спрайта
+   * \param stride      расстояние между соседними углами в float
+   * \note Для каждого спрайта записываются 4 угла в порядке: левый нижний,
+   * левый верхний, правый нижний, правый верхний (до поворота). Записывается
+   * только положение угла (2 float), остальные данные вершины не изменяются
+   */
+  static void transform_quads(const sprite_transform_input& input,
+                              float* corners, size_t stride);
+
+  /*!
+   * \brief Скалярная реализация преобразования
+   * \note Используется для сравнения производительности и проверки ядра
+   */
+  static void transform_quads_scalar(const sprite_transform_input& input,
+                                     float* corners, size_t stride);
+
+  sprite_transform() = delete;
+};
+}  // namespace render
@@ -1,13 +1,39 @@
 #pragma once
 #include <glad/glad.h>
 #include <render/shader_program.h>
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 namespace render
 {
 struct shader_program::sprogram_impl
 {
+  /*!
+   * \brief Последнее загруженное значение uniform-поля
+   */
+  struct uniform_value
+  {
+    bool assigned{false};
+    std::array<unsigned char, sizeof(glm::mat4x4)> data{};
+  };
+
   bool create_shader(const std::string& source, GLenum s_type,
                      GLuint& shader_id);
+  /*!
+   * \brief Чтение активных uniform-полей, uniform-блоков и атрибутов
+   * скомпонованной программы
+   */
+  void reflect();
+
   bool compile_status{false};
   GLuint id{0};
+
+  std::unordered_map<std::string, GLint> uniforms{};
+  std::unordered_map<std::string, GLint> attributes{};
+  std::unordered_map<std::string, GLuint> blocks{};  ///< номера uniform-блоков
+  std::vector<uniform_value> values{};  ///< значения по номеру uniform-поля
+  std::unordered_set<std::string> reported{};  ///< ненайденные uniform-поля
 };
 }  // namespace render
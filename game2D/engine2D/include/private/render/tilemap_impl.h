@@ -0,0 +1,83 @@
+#pragma once
+#include <render/index_buffer.h>
+#include <render/shader_program.h>
+#include <render/sprite_batch.h>
+#include <render/tilemap.h>
+#include <render/vertex_array.h>
+#include <render/vertex_buffer.h>
+#include <render/vertex_buffer_descriptor.h>
+#include <memory>
+#include <vector>
+namespace render
+{
+struct tilemap::tilemap_impl
+{
+  /*!
+   * \brief gl-объекты чанка
+   * \note Вершинный буфер создается с емкостью всех тайлов чанка, поэтому
+   * пересборка не выделяет новое хранилище
+   */
+  struct chunk_mesh
+  {
+    vertex_array vao{};
+    vertex_buffer vbo{buffer_usage::static_draw};
+  };
+
+  /*!
+   * \brief Чанк карты
+   * \note Поля quads и dirty принадлежат игровому потоку, а mesh - потоку,
+   * выполняющему команды отрисовки
+   */
+  struct chunk
+  {
+    std::unique_ptr<chunk_mesh> mesh{};  ///< создается при первой загрузке
+    unsigned int quads{0};  ///< количество непустых тайлов
+    bool dirty{true};       ///< вершины не соответствуют тайлам
+  };
+
+  /*!
+   * \brief Вершины пересобранного чанка, ожидающие загрузки
+   */
+  struct chunk_upload
+  {
+    unsigned int chunk;
+    std::vector<sprite_batch::vertex> vertices;
+  };
+
+  /*!
+   * \brief Видимый чанк кадра
+   */
+  struct visible_chunk
+  {
+    unsigned int chunk;
+    unsigned int quads;
+  };
+
+  /*!
+   * \brief Загрузка пересобранных чанков и отрисовка видимых
+   * \note Выполняется командой отрисовки и использует только переданные
+   * данные кадра и gl-объекты чанков
+   */
+  void draw(shader_program& program, texture2D& atlas,
+            const glm::mat4x4& model_matrix, int map_layer,
+            const std::vector<visible_chunk>& visible,
+            const std::vector<chunk_upload>& uploads);
+
+  std::vector<int> tiles{};
+  std::vector<frame_descriptor> tile_set{};
+  std::vector<chunk> chunks{};
+  unsigned int chunk_columns{0};
+  unsigned int chunk_rows{0};
+
+  unsigned int chunk_size{0};
+  std::vector<chunk_upload> uploads{};  ///< пересобранные чанки кадра
+
+  std::unique_ptr<index_buffer> ibo{};  ///< общий буфер индексов чанков
+  vertex_buffer_descriptor descriptor{};
+
+  uniform<glm::mat4x4> model{};
+  uniform<int> texture{};
+  uniform<int> layer{};
+  bool uniforms_resolved{false};
+};
+}  // namespace render
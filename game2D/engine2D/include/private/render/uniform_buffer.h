@@ -0,0 +1,62 @@
+#pragma once
+#include <glad/glad.h>
+#include <render/buffer_usage.h>
+namespace render
+{
+/*!
+ * \brief Буфер uniform-блока
+ * Оболочка gl-буфера, хранящего значения uniform-блока шейдеров. Буфер
+ * привязывается к номеру точки привязки, и все программы, блоки которых
+ * связаны с этой точкой, читают одни и те же данные без загрузки
+ * uniform-полей при каждой отрисовке.
+ * \note Данные буфера должны соответствовать раскладке std140
+ * \sa render::shader_program::bind_uniform_block
+ */
+class uniform_buffer
+{
+ public:
+  /*!
+   * \brief Инициализация
+   * \param binding     номер точки привязки uniform-блоков
+   * \param size        размер буфера в байтах
+   * \param usage       способ использования буфера
+   */
+  uniform_buffer(unsigned int binding, unsigned int size,
+                 buffer_usage usage = buffer_usage::dynamic_draw);
+
+  /*!
+   * \brief Загрузка данных
+   * \param size    размер данных в байтах, не больше размера буфера
+   * \param data    указатель на данные
+   * \note Для динамических буферов выделяется новое хранилище (orphaning),
+   * поэтому запись не ожидает завершения отрисовок, читающих старые данные
+   */
+  void update(const unsigned int size, const void* data);
+
+  /*!
+   * \brief Привязка буфера к его точке привязки
+   * \note Выполняется при инициализации. Повторный вызов нужен, только если
+   * точку привязки занимал другой буфер
+   */
+  void bind_base() const;
+
+  unsigned int get_binding() const { return binding; }
+  unsigned int get_size() const { return size; }
+
+  ~uniform_buffer();
+
+  uniform_buffer(uniform_buffer&&);
+  uniform_buffer& operator=(uniform_buffer&&);
+
+  uniform_buffer(uniform_buffer&) = delete;
+  uniform_buffer& operator=(uniform_buffer&) = delete;
+
+ private:
+  GLuint id{0};
+  unsigned int binding{0};
+  unsigned int size{0};
+  buffer_usage usage{buffer_usage::dynamic_draw};
+
+  static const GLenum buffer_type{GL_UNIFORM_BUFFER};
+};
+}  // namespace render
@@ -53,9 +53,30 @@ class vertex_array
    * \note При взаимподействии с render::vertex_buffer всегда будьте уверены,
    * что vertex_buffer будет существовать до удаления vao-объекта.
    * Лучше всего хранить их в виде полей класса.
+   * \param divisor     делитель атрибутов: 0 - данные берутся для каждой
+   * вершины, N - данные сменяются через каждые N экземпляров при инстансной
+   * отрисовке
    */
   void bind_vertex_buffer(const vertex_buffer& buffer,
-                          const vertex_buffer_descriptor& descriptor);
+                          const vertex_buffer_descriptor& descriptor,
+                          unsigned int divisor = 0);
+
+  /*!
+   * \brief Смещение данных привязанного вершинного буфера
+   * Перенастраивает атрибуты, ранее привязанные к vao функцией
+   * vertex_array::bind_vertex_buffer, на данные буфера, начинающиеся со
+   * смещения offset. Делители атрибутов не изменяются.
+   * \param buffer            привязанный вершинный буфер
+   * \param descriptor        описатель, использованный при привязке
+   * \param first_attribute   номер первого атрибута буфера в vao
+   * \param offset            смещение данных в буфере в байтах
+   * \sa render::vertex_buffer::stream(const unsigned int size, const void*
+   * data)
+   */
+  void set_vertex_buffer_offset(const vertex_buffer& buffer,
+                                const vertex_buffer_descriptor& descriptor,
+                                unsigned int first_attribute,
+                                unsigned int offset);
 
   /*!
    * \brief Возвращает количество используемых атрибутов vao
@@ -72,6 +93,10 @@ class vertex_array
   vertex_array& operator=(vertex_array&) = delete;
 
  private:
+  void set_attribute_pointers(const vertex_buffer_descriptor& descriptor,
+                              unsigned int first_attribute,
+                              unsigned int offset);
+
   GLuint id{0};
   unsigned int va_arrays_count{0};
 };
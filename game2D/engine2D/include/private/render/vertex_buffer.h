@@ -1,5 +1,7 @@
 #pragma once
 #include <glad/glad.h>
+#include <render/buffer_usage.h>
+#include <array>
 namespace render
 {
 /*!
@@ -15,22 +17,29 @@ namespace render
  * \note Все динамические данные, поступающие в класс
  * могут быть удалены после инициализации, так как они полностью копируются в
  * память видеокарты.
+ * \note Буфер с способом использования buffer_usage::stream_draw может
+ * использоваться как кольцевой буфер для данных, перезаписываемых каждый
+ * кадр.
+ * \sa render::vertex_buffer::stream(const unsigned int size, const void* data)
  */
 class vertex_buffer
 {
  public:
   /*!
    * \brief Инициализация бустого буфера вершин
+   * \param usage   способ использования буфера
    */
-  vertex_buffer();
+  explicit vertex_buffer(buffer_usage usage = buffer_usage::static_draw);
 
   /*!
    * \brief Инициализация с заполнением
    * \param size    размер данных в байтах
    * \param data    указатель на загружаемые данные
+   * \param usage   способ использования буфера
    * \note Данные data могут быть удалены после инициализации
    */
-  vertex_buffer(const unsigned int size, const void* data);
+  vertex_buffer(const unsigned int size, const void* data,
+                buffer_usage usage = buffer_usage::static_draw);
 
   /*!
    * \brief Активация буфера вершин
@@ -70,10 +79,52 @@ class vertex_buffer
    * \param data    указатель на загружаемые данные
    * \note Данные data могут быть удалены после использования
    * \note Буфер автоматически выполняет команду render::vertex_buffer::bind()
+   * \note Динамические и потоковые буферы перед записью освобождают старое
+   * хранилище (orphaning), поэтому запись не ожидает завершения отрисовок,
+   * использующих прежние данные
    * \sa render::vertex_buffer::bind()
    */
   void update(const unsigned int size, const void* data);
 
+  /*!
+   * \brief Изменение части буфера
+   * Перезаписывает данные буфера, начиная со смещения offset, сохраняя
+   * остальные данные
+   * \param offset  смещение в байтах
+   * \param size    размер данных в байтах
+   * \param data    указатель на загружаемые данные
+   * \note Хранилище не освобождается, поэтому offset + size не должны
+   * превышать размер буфера, заданный render::vertex_buffer::restore
+   */
+  void update_range(const unsigned int offset, const unsigned int size,
+                    const void* data);
+
+  /*!
+   * \brief Потоковая запись в кольцевой буфер
+   * Записывает данные в сегмент буфера, принадлежащий текущему кадру, через
+   * glMapBufferRange без синхронизации. Буфер разделен на
+   * vertex_buffer::ring_segments сегментов, и перед повторным использованием
+   * сегмента ожидается gl-барьер, установленный после его последнего кадра,
+   * поэтому запись не останавливает конвейер.
+   * \param size    размер данных в байтах
+   * \param data    указатель на загружаемые данные
+   * \return Смещение записанных данных в буфере в байтах
+   * \note Если данные не помещаются в сегмент, буфер увеличивается и ранее
+   * полученные смещения становятся недействительными, поэтому отрисовку
+   * следует выполнять сразу после записи
+   * \note Используется только с буферами buffer_usage::stream_draw
+   * \sa render::vertex_array::set_vertex_buffer_offset
+   */
+  unsigned int stream(const unsigned int size, const void* data);
+
+  /*!
+   * \brief Завершение кадра кольцевого буфера
+   * Устанавливает gl-барьер для сегмента текущего кадра и переходит к
+   * следующему сегменту
+   * \note Вызывается рендером в конце каждого кадра
+   */
+  void end_frame();
+
   ~vertex_buffer();
 
   vertex_buffer(vertex_buffer&&);
@@ -82,9 +133,21 @@ class vertex_buffer
   vertex_buffer(vertex_buffer&) = delete;
   vertex_buffer operator=(vertex_buffer&) = delete;
 
+  static constexpr unsigned int ring_segments{3};
+
  private:
+  void release_fences();
+  void wait_segment();
+
   GLuint id{0};
   unsigned int size{0};
+  buffer_usage usage{buffer_usage::static_draw};
+
+  unsigned int segment_size{0};  ///< размер сегмента кольцевого буфера
+  unsigned int segment{0};       ///< сегмент текущего кадра
+  unsigned int cursor{0};        ///< смещение записи в сегменте
+  std::array<GLsync, ring_segments> fences{};
+
   static const GLenum buffer_type{GL_ARRAY_BUFFER};
 };
 }  // namespace render
@@ -0,0 +1,63 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+namespace render
+{
+/*!
+ * \brief Пул рабочих потоков
+ * Выполняет задачу, разбитую на независимые части, в нескольких потоках.
+ * Потоки создаются один раз и ожидают работы между вызовами, поэтому
+ * разбиение задачи не требует создания потоков в каждом кадре.
+ * \note Вызывающий поток тоже выполняет части задачи
+ */
+class worker_pool
+{
+ public:
+  /*!
+   * \brief Инициализация пула
+   * \param workers количество потоков пула, кроме вызывающего
+   */
+  explicit worker_pool(unsigned int workers);
+
+  /*!
+   * \brief Выполнение задачи
+   * Вызывает task(part) для каждого part из [0; parts) и дожидается
+   * завершения всех частей
+   * \note Части выполняются в произвольном порядке разными потоками и не
+   * должны изменять общие данные
+   */
+  void run(unsigned int parts, const std::function<void(unsigned int)>& task);
+
+  unsigned int get_workers() const
+  {
+    return static_cast<unsigned int>(threads.size());
+  }
+
+  ~worker_pool();
+
+  worker_pool(worker_pool&) = delete;
+  worker_pool& operator=(worker_pool&) = delete;
+
+ private:
+  void work();
+  /*!
+   * \brief Выполнение свободных частей текущей задачи
+   */
+  void execute_parts();
+
+  std::mutex mutex{};
+  std::condition_variable start{};
+  std::condition_variable done{};
+  const std::function<void(unsigned int)>* task{nullptr};
+  unsigned int parts{0};
+  unsigned int next_part{0};      ///< первая невыданная часть
+  unsigned int finished_parts{0};
+  unsigned long long generation{0};  ///< номер текущей задачи
+  bool stopping{false};
+
+  std::vector<std::thread> threads{};
+};
+}  // namespace render
@@ -0,0 +1,54 @@
+#pragma once
+#include <render/texture2D.h>
+#include <string>
+#include <vector>
+namespace resources
+{
+/*!
+ * \brief Загрузчик текстур в контейнере KTX
+ * Разбирает файлы KTX 1.1 и KTX 2.0 с двумерными текстурами без
+ * суперсжатия. Поддерживаются форматы render::color_format: несжатые
+ * rgb/rgba, 16-битные rgb565/rgba4444 и сжатые ETC2/EAC.
+ * \note Массивы текстур, кубические и трехмерные текстуры не поддерживаются
+ */
+class ktx_loader
+{
+ public:
+  /*!
+   * \brief Разобранная текстура
+   * \note Уровни детализации указывают на данные файла или, если строки
+   * в файле выровнены, на плотно упакованные копии в packed_levels
+   */
+  struct image
+  {
+    render::color_format format{render::color_format::rgba};
+    std::vector<render::texture2D::level> levels{};
+    bool bottom_up{false};  ///< первая строка данных является нижней
+    /*!
+     * \brief Файл не содержит уровней детализации и требует их построения
+     * (количество уровней в заголовке равно 0)
+     */
+    bool generate_mipmaps{false};
+    /*!
+     * \brief Уровни, строки которых переупакованы без выравнивания
+     * \note Должны существовать до загрузки текстуры
+     */
+    std::vector<std::vector<unsigned char>> packed_levels{};
+  };
+
+  /*!
+   * \brief Разбор содержимого файла
+   * \param data    содержимое файла, должно существовать до загрузки текстуры
+   * \param result  разобранная текстура
+   * \return false - файл не является поддерживаемой KTX-текстурой, причина
+   * выводится в log
+   */
+  static bool parse(const std::string& data, image& result);
+
+  ktx_loader() = delete;
+
+ private:
+  static bool parse_ktx1(const std::string& data, image& result);
+  static bool parse_ktx2(const std::string& data, image& result);
+};
+}  // namespace resources
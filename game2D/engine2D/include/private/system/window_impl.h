@@ -20,6 +20,15 @@ class window_impl final : public window
   ~window_impl() override;
 
   void swap_buffers();
+  /*!
+   * \brief Привязка gl-контекста окна к вызывающему потоку
+   * \return false - контекст не удалось сделать текущим
+   */
+  bool make_current();
+  /*!
+   * \brief Отвязка gl-контекста окна от вызывающего потока
+   */
+  void release_context();
 
   window_impl(window_impl&&);
   window_impl& operator=(window_impl&&);
@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <vector>
 namespace sound
 {
 class sound_buffer;
@@ -9,6 +10,12 @@ namespace input
 {
 class input_manager;
 }
+namespace render
+{
+struct frame_stats;
+struct post_process_pass;
+class camera2D;
+}
 namespace core
 {
 class igame;
@@ -70,20 +77,81 @@ class engine
    * - четние событий ввода
    * - изменение данных игрового мира
    * - подготовка видео-буфера к заполнению
+   * - загрузка uniform-блока данных кадра (камера, время, размер области
+   * отрисовки)
    * - обработка звука и изображения для нового кадра
+   * - отрисовка накопленных пакетов спрайтов
    * - переключение видео-буфера.
    * \param game    объект игрового мира
    * \note Всегда используйте данный метод как основной игровой цикл. В ином
    * случае у вас не будет доступа к переключению виде-буфера
    * \note Цикл останавливается, когда функция igame::is_playing() возвращает
    * false;
+   * \note При включенном window_properties::render_thread отрисовка и
+   * переключение видео-буфера выполняются потоком рендера параллельно с
+   * обработкой следующего кадра
+   * \note Для игры, реализующей ifixed_step_game, данные обновляются
+   * фиксированными шагами, а отрисовка получает долю незавершенного шага
    * \sa igame::is_playing()
+   * \sa ifixed_step_game
    */
   static void launch(igame& game);
 
   static window& get_window();
   static audio& get_audio();
 
+  /*!
+   * \brief Камера рендера
+   * Определяет видимую область мира. Спрайты вне видимой области не
+   * отрисовываются
+   * \sa render::camera2D
+   */
+  static render::camera2D& get_camera();
+
+  /*!
+   * \brief Статистика отрисовки последнего завершенного кадра
+   * \return Количество вызовов отрисовки, выполненных и пропущенных gl-вызовов
+   * смены состояния, отрисованных и отсеченных спрайтов
+   * \sa render::frame_stats
+   */
+  static const render::frame_stats& get_frame_stats();
+
+  /*!
+   * \brief Запрос снимка текущего кадра
+   * Пиксели кадра читаются после отрисовки, до переключения видео-буфера.
+   * Вызывается во время обработки кадра, например в igame::render_output()
+   * \note При включенном window_properties::headless снимок читается из
+   * внеэкранного буфера кадра
+   * \sa engine::get_captured_frame
+   */
+  static void capture_frame();
+  /*!
+   * \brief Получение последнего снимка кадра
+   * \param rgba    пиксели снимка, по 4 байта rgba на пиксель, строки
+   * сверху вниз
+   * \param width   ширина снимка
+   * \param height  высота снимка
+   * \return false - снимок еще не готов
+   * \note При включенном window_properties::render_thread снимок готов
+   * после отрисовки кадра потоком рендера, то есть не раньше следующего
+   * кадра
+   */
+  static bool get_captured_frame(std::vector<unsigned char>& rgba, int& width,
+                                 int& height);
+
+  /*!
+   * \brief Установка цепочки постобработки кадра
+   * \param passes      полноэкранные проходы, пустой список отключает
+   * постобработку
+   * \param profile     true - время каждого прохода в статистике кадра
+   * включает работу видеокарты, ценой ожидания завершения прохода
+   * \sa render::post_process_pass
+   * \sa render::frame_stats::post_pass_ms
+   */
+  static void set_post_process(
+      const std::vector<render::post_process_pass>& passes,
+      bool profile = false);
+
  private:
   inline static bool initialized{false};
   friend class sound::sound_buffer;
@@ -0,0 +1,51 @@
+#pragma once
+#include <core/igame.h>
+namespace core
+{
+/*!
+ * \brief Настройки фиксированного шага симуляции
+ */
+struct fixed_step_settings
+{
+  double tick_rate{60.0};  ///< частота обновления данных, шагов в секунду
+  /*!
+   * \brief Наибольшее количество шагов за кадр
+   * Если за кадр накопилось больше шагов (долгий кадр, остановка в
+   * отладчике), лишние шаги отбрасываются, и симуляция замедляется вместо
+   * того, чтобы догонять время все более долгими кадрами
+   */
+  unsigned int max_steps{5};
+};
+
+/*!
+ * \brief ifixed_step_game - игра с фиксированным шагом симуляции
+ * \details Класс engine вызывает update_data с постоянной длительностью
+ * шага, от нуля до fixed_step_settings::max_steps раз за кадр, независимо
+ * от частоты кадров. read_input вызывается один раз за кадр с
+ * длительностью кадра. Отрисовка выполняется с частотой кадров и получает
+ * долю шага, прошедшую после последнего обновления, для интерполяции между
+ * предыдущим и текущим состоянием объектов.
+ * \note Используйте реализацию данного класса вместо igame, если
+ * симуляция должна работать с частотой, отличной от частоты кадров
+ * (например, 30 шагов в секунду при отрисовке с частотой экрана)
+ */
+class ifixed_step_game : public igame
+{
+ public:
+  /*!
+   * \brief Настройки шага симуляции
+   * \note Запрашиваются один раз при запуске игрового цикла
+   */
+  virtual fixed_step_settings get_fixed_step() { return {}; }
+  /*!
+   * \brief Действия по обработке изображения и звука
+   * \param alpha   доля шага, прошедшая после последнего вызова
+   * update_data, в диапазоне [0, 1). Состояние для отрисовки - смешивание
+   * предыдущего и текущего состояний с весом alpha
+   * \sa igame::render_output()
+   */
+  virtual void render_output(double alpha) = 0;
+
+  void render_output() final { render_output(1.0); }
+};
+}  // namespace core
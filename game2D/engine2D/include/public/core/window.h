@@ -9,6 +9,46 @@ struct window_properties
   int height{0};
   std::string title{0};
   bool debug_enabled{false};
+  bool sprite_batching{true};  ///< пакетная отрисовка спрайтов
+  /*!
+   * \brief Отрисовка в отдельном потоке рендера
+   * Игровой поток только записывает кадры, а поток рендера, владеющий
+   * gl-контекстом, отрисовывает их и переключает буферы. Обновление кадра
+   * N + 1 выполняется одновременно с отрисовкой кадра N.
+   * \note Во время работы core::engine::launch игра не должна создавать и
+   * удалять gl-ресурсы (текстуры, программы, наборы ресурсов): загружайте
+   * их до запуска цикла
+   * \note Спрайты всегда накапливаются в пакете, sprite_batching
+   * игнорируется
+   */
+  bool render_thread{false};
+  /*!
+   * \brief Режим без отображения окна
+   * Окно создается скрытым драйвером offscreen библиотеки SDL (контекст egl
+   * без поверхности экрана), а кадры отрисовываются во внеэкранный буфер
+   * кадра размером width x height. Переключение буферов не выполняется,
+   * поэтому частота кадров не ограничена вертикальной синхронизацией.
+   * Используется для замеров производительности и сравнения снимков кадров.
+   * \note Драйверы видео и звука выбираются при инициализации движка, если
+   * они не заданы переменными окружения SDL_VIDEODRIVER и SDL_AUDIODRIVER
+   * \sa core::engine::capture_frame()
+   */
+  bool headless{false};
+  /*!
+   * \brief Динамическое разрешение
+   * Кадр отрисовывается во внеэкранную цель уменьшенного размера и
+   * растягивается до размера окна. Масштаб разрешения уменьшается шагами
+   * 1/8, когда кадры превышают frame_budget_ms, и возвращается, когда
+   * кадры снова укладываются в бюджет. Цели отрисовки берутся из пула, и
+   * каждый масштаб выделяется только один раз.
+   * \note При вертикальной синхронизации длительность кадра не бывает
+   * меньше периода обновления экрана, поэтому масштаб увеличивается пробно,
+   * а неудачные пробы повторяются все реже
+   * \sa render::frame_stats::resolution_scale
+   */
+  bool dynamic_resolution{false};
+  float frame_budget_ms{16.6f};  ///< бюджет кадра в миллисекундах
+  float min_resolution_scale{0.5f};  ///< наименьший масштаб разрешения
 };
 
 class window
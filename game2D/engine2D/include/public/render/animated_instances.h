@@ -0,0 +1,116 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <render/sprite_animator.h>
+#include <memory>
+#include <vector>
+namespace render
+{
+class texture2D;
+class shader_program;
+
+/*!
+ * \brief Набор анимированных экземпляров, вычисляемых видеокартой
+ * Кадры клипов (области текстуры и время окончания каждого кадра)
+ * загружаются один раз в небольшую текстуру-таблицу. Каждый экземпляр
+ * хранит номер клипа и время начала проигрывания, а вершинный шейдер
+ * выбирает текущий кадр по времени из блока данных кадра. Поэтому
+ * проигрываемые анимации не требуют ни обновления на процессоре, ни
+ * загрузки буферов: данные экземпляров загружаются только после их
+ * изменения.
+ * \note Отрисовка требует шейдер с атрибутами экземпляров:
+ * - location 0 - vec2, вершина единичного квада
+ * - location 1 - vec4, положение (xy) и размер (zw)
+ * - location 2 - vec2, угол поворота в градусах (x) и слой (y)
+ * - location 3 - vec2, номер клипа (x) и время начала в секундах (y)
+ * и uniform-поля:
+ * - s_texture           - sampler2D, атлас кадров
+ * - s_animation_table   - sampler2D, таблица клипов (блок 1)
+ * - frame_data - uniform-блок данных кадра
+ * \note Время проигрывания отсчитывается от запуска, поэтому пауза и
+ * изменение скорости отдельного экземпляра не поддерживаются. Для них
+ * используйте render::animation_world
+ * \sa res/shaders/animated_shader.vert
+ */
+class animated_instances
+{
+ public:
+  using clip_id = unsigned int;
+
+  /*!
+   * \brief Инициализация набора
+   * \param texture     атлас кадров всех клипов набора
+   * \param program     шейдерная программа с таблицей клипов
+   */
+  animated_instances(std::shared_ptr<texture2D> texture,
+                     std::shared_ptr<shader_program> program);
+
+  /*!
+   * \brief Добавление клипа
+   * \param frames  кадры клипа с длительностями, как у
+   * render::sprite_animator
+   * \return Номер клипа
+   * \note Отрицательная длительность останавливает клип на этом кадре.
+   * Клип без кадров отрисовывает всю текстуру
+   * \note Таблица клипов загружается повторно при следующей отрисовке
+   */
+  clip_id add_clip(const std::vector<sprite_animator::frame>& frames);
+
+  /*!
+   * \brief Добавление экземпляра
+   * \param clip        номер клипа
+   * \param settings    свойства отрисовки экземпляра
+   * \param offset      начальное время клипа в миллисекундах
+   * \return Номер экземпляра
+   * \note Проигрывание начинается с текущего времени кадра
+   * \sa render::renderer::get_time
+   */
+  unsigned int add(clip_id clip, const render_settings& settings,
+                   double offset = 0);
+  /*!
+   * \brief Замена клипа экземпляра
+   * Проигрывание нового клипа начинается с offset
+   */
+  void play(unsigned int instance, clip_id clip, double offset = 0);
+  /*!
+   * \brief Изменение свойств отрисовки без перезапуска клипа
+   */
+  void set_settings(unsigned int instance, const render_settings& settings);
+
+  /*!
+   * \brief Установка класса смешивания набора
+   */
+  void set_blend(blend_mode blend);
+
+  /*!
+   * \brief Удаление всех экземпляров
+   */
+  void clear();
+
+  size_t get_count() const;
+
+  /*!
+   * \brief Отрисовка всех экземпляров
+   * Отправляет одну команду инстансной отрисовки, если границы набора
+   * попадают в видимую область камеры. Изменившиеся данные экземпляров и
+   * таблица клипов загружаются этой же командой
+   * \note В списке отрисовки набор сортируется по наименьшему слою своих
+   * экземпляров
+   */
+  void render();
+
+  ~animated_instances();
+
+  animated_instances(animated_instances&&);
+  animated_instances& operator=(animated_instances&&);
+
+  animated_instances(animated_instances&) = delete;
+  animated_instances& operator=(animated_instances&) = delete;
+
+ private:
+  std::shared_ptr<shader_program> program;
+  std::shared_ptr<texture2D> texture;
+
+  struct instances_impl;
+  std::unique_ptr<instances_impl> impl{};
+};
+}  // namespace render
@@ -0,0 +1,135 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <memory>
+#include <vector>
+namespace render
+{
+class texture2D;
+class shader_program;
+
+/*!
+ * \brief Клип анимации
+ * Неизменяемый список кадров одного текстурного атласа, общий для всех
+ * экземпляров анимации, которые на него ссылаются
+ * \sa render::animation_world::add_clip
+ */
+struct animation_clip
+{
+  std::shared_ptr<texture2D> texture{};        ///< атлас кадров
+  std::shared_ptr<shader_program> program{};  ///< программа спрайтов
+  std::vector<frame_descriptor> frames{};      ///< области кадров
+  std::vector<double> durations{};  ///< длительности кадров в миллисекундах
+  bool looped{true};  ///< false - анимация останавливается на последнем кадре
+};
+
+/*!
+ * \brief Мир анимаций
+ * Хранит общие клипы анимации и экземпляры, проигрывающие их. Состояние
+ * экземпляров хранится отдельными массивами по каждому свойству (SoA), и
+ * все экземпляры обновляются одним проходом. Обновление переходит через
+ * любое количество кадров, поэтому после долгого кадра анимация не
+ * отстает.
+ * При отрисовке области текущих кадров экземпляров передаются
+ * непосредственно в пакет спрайтов.
+ * \note Экземпляры адресуются постоянными номерами, которые не меняются при
+ * удалении других экземпляров
+ * \note Отрисовка требует тех же полей шейдера, что и render::sprite2D
+ * \sa render::sprite_animator
+ */
+class animation_world
+{
+ public:
+  using clip_id = unsigned int;
+  using instance_id = unsigned int;
+
+  animation_world();
+
+  /*!
+   * \brief Добавление клипа
+   * \param clip    клип, количество длительностей должно совпадать с
+   * количеством кадров
+   * \return Номер клипа
+   * \note Клип без кадров отрисовывает всю текстуру
+   */
+  clip_id add_clip(const animation_clip& clip);
+  /*!
+   * \brief Клип по номеру
+   */
+  const animation_clip& get_clip(clip_id clip) const;
+  /*!
+   * \brief Продолжительность клипа в миллисекундах
+   */
+  double get_clip_duration(clip_id clip) const;
+
+  /*!
+   * \brief Создание экземпляра
+   * \param clip        номер проигрываемого клипа
+   * \param settings    параметры отрисовки экземпляра
+   * \return Номер экземпляра
+   * \note Экземпляр начинает проигрывание с первого кадра
+   */
+  instance_id create(clip_id clip, const render_settings& settings);
+  /*!
+   * \brief Удаление экземпляра
+   * \note Номер удаленного экземпляра может быть выдан новому экземпляру
+   */
+  void destroy(instance_id instance);
+
+  /*!
+   * \brief Запуск клипа
+   * \param instance    номер экземпляра
+   * \param clip        номер клипа
+   * \param restart     true - проигрывание начинается с первого кадра,
+   * false - сохраняется текущее время
+   */
+  void play(instance_id instance, clip_id clip, bool restart = true);
+  /*!
+   * \brief Приостановка и возобновление проигрывания
+   */
+  void set_paused(instance_id instance, bool paused);
+  /*!
+   * \brief Скорость проигрывания, 1 - обычная
+   */
+  void set_speed(instance_id instance, float speed);
+
+  /*!
+   * \brief Параметры отрисовки экземпляра
+   */
+  render_settings& get_settings(instance_id instance);
+  /*!
+   * \brief Номер текущего кадра экземпляра
+   */
+  unsigned int get_frame(instance_id instance) const;
+  /*!
+   * \brief Состояние проигрывания
+   * \return false - проигрывание приостановлено или неповторяемый клип
+   * завершен
+   */
+  bool is_playing(instance_id instance) const;
+
+  /*!
+   * \brief Обновление всех экземпляров
+   * \param duration    прошедшее время в миллисекундах
+   */
+  void update(double duration);
+  /*!
+   * \brief Отрисовка всех экземпляров
+   * Передает текущие кадры экземпляров в пакет спрайтов
+   */
+  void render();
+
+  size_t get_count() const;
+
+  ~animation_world();
+
+  animation_world(animation_world&&);
+  animation_world& operator=(animation_world&&);
+
+  animation_world(animation_world&) = delete;
+  animation_world& operator=(animation_world&) = delete;
+
+ private:
+  struct world_impl;
+  std::unique_ptr<world_impl> impl{};
+};
+}  // namespace render
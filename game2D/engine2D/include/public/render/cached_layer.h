@@ -0,0 +1,85 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <glm/vec2.hpp>
+#include <functional>
+#include <memory>
+namespace render
+{
+class shader_program;
+class command_list;
+
+/*!
+ * \brief Кэшированный слой
+ * Отрисовывает редко изменяющееся содержимое (фон, элементы интерфейса)
+ * один раз в текстуру и в каждом кадре выводит эту текстуру одним квадом.
+ * Содержимое перерисовывается только после вызова
+ * cached_layer::invalidate(). Текстуры слоев берутся из общего пула целей
+ * отрисовки рендера по размеру и формату.
+ * \note Содержимое записывается в мировых координатах области слоя, заданной
+ * cached_layer::set_area, а выводится в области, заданной свойствами
+ * отрисовки слоя. По умолчанию обе области совпадают
+ * \note Вывод требует тех же атрибутов и полей шейдера, что и
+ * render::sprite_instances. Текстура слоя содержит предумноженный цвет
+ * \sa res/shaders/instanced_shader.vert
+ */
+class cached_layer
+{
+ public:
+  /*!
+   * \brief Инициализация слоя
+   * \param program     инстансная программа вывода текстуры слоя
+   * \param settings    свойства отрисовки слоя: область вывода, слой
+   * сортировки и класс смешивания
+   * \param resolution  размер текстуры слоя в пикселях
+   */
+  cached_layer(std::shared_ptr<shader_program> program,
+               const render_settings& settings, const glm::ivec2& resolution);
+
+  /*!
+   * \brief Установка области содержимого
+   * \param position    левый нижний угол области в мировых координатах
+   * \param size        размер области
+   * \note Делает содержимое недействительным
+   */
+  void set_area(const glm::vec2& position, const glm::vec2& size);
+  /*!
+   * \brief Свойства вывода слоя
+   * \note Изменение свойств не перерисовывает содержимое
+   */
+  render_settings& get_settings() { return settings; }
+
+  /*!
+   * \brief Пометка содержимого как недействительного
+   * Содержимое будет перерисовано при следующем вызове
+   * cached_layer::render
+   */
+  void invalidate();
+  bool is_valid() const;
+
+  /*!
+   * \brief Отрисовка слоя
+   * Если содержимое недействительно, вызывает record со списком команд,
+   * камера которого охватывает область слоя, и перерисовывает текстуру.
+   * Затем отправляет команду вывода текстуры
+   * \param record  запись содержимого: sprite2D::render(command_list&, ...)
+   * и command_list::add
+   * \note Слой вне видимой области камеры не выводится и не перерисовывается
+   */
+  void render(const std::function<void(command_list&)>& record);
+
+  ~cached_layer();
+
+  cached_layer(cached_layer&&);
+  cached_layer& operator=(cached_layer&&);
+
+  cached_layer(cached_layer&) = delete;
+  cached_layer& operator=(cached_layer&) = delete;
+
+ private:
+  std::shared_ptr<shader_program> program;
+  render_settings settings;
+
+  struct layer_impl;
+  std::unique_ptr<layer_impl> impl{};
+};
+}  // namespace render
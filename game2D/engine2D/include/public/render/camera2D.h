@@ -0,0 +1,104 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+namespace render
+{
+/*!
+ * \brief Двумерная камера
+ * Задает видимую область мира: положение центра, масштаб и поворот.
+ * Матрица вида-проекции камеры загружается один раз за кадр в uniform-блок
+ * данных кадра frame_data, общий для всех шейдеров, а спрайты, не
+ * попадающие в видимую область, отбрасываются до попадания в пакет
+ * отрисовки.
+ * \note По умолчанию видимая область имеет размер 2x2 с центром в начале
+ * координат, то есть мировые координаты совпадают с диапазоном [-1;1]
+ * \note Изменяйте камеру до отрисовки спрайтов кадра: отсечение выполняется
+ * при отправке спрайта, а матрица загружается при сбросе пакета
+ * \sa core::engine::get_camera()
+ */
+class camera2D
+{
+ public:
+  /*!
+   * \brief Границы видимой области
+   * Ограничивающий прямоугольник видимой области в мировых координатах
+   */
+  struct bounds
+  {
+    glm::vec2 min{0};  ///< левый нижний угол
+    glm::vec2 max{0};  ///< правый верхний угол
+  };
+
+  camera2D() = default;
+
+  /*!
+   * \brief Установка положения центра камеры
+   * \param position    положение центра в мировых координатах
+   */
+  void set_position(const glm::vec2& position);
+  /*!
+   * \brief Установка масштаба
+   * \param zoom    масштаб, больше 1 - приближение, меньше 1 - отдаление
+   * \note Неположительные значения игнорируются
+   */
+  void set_zoom(float zoom);
+  /*!
+   * \brief Установка угла поворота камеры
+   * \param rotation    угол поворота в градусах
+   */
+  void set_rotation(float rotation);
+  /*!
+   * \brief Установка размера видимой области при масштабе 1
+   * \param view_size   ширина и высота видимой области в мировых координатах
+   * \note Неположительные значения игнорируются
+   */
+  void set_view_size(const glm::vec2& view_size);
+
+  const glm::vec2& get_position() const { return position; }
+  float get_zoom() const { return zoom; }
+  float get_rotation() const { return rotation; }
+  const glm::vec2& get_view_size() const { return view_size; }
+
+  /*!
+   * \brief Матрица вида-проекции
+   * Переводит мировые координаты в нормализованные координаты экрана
+   * \note Матрица пересчитывается только после изменения камеры
+   */
+  const glm::mat4x4& get_view_projection() const;
+
+  /*!
+   * \brief Границы видимой области
+   * \note При повороте камеры возвращается описанный прямоугольник
+   */
+  const bounds& get_bounds() const;
+
+  /*!
+   * \brief Проверка видимости спрайта
+   * \param settings    свойства отрисовки спрайта
+   * \return true - спрайт может попасть в видимую область
+   * \note Проверка консервативна: спрайт заменяется описанной окружностью,
+   * поэтому результат не зависит от поворота спрайта
+   */
+  bool is_visible(const render_settings& settings) const;
+  /*!
+   * \brief Проверка видимости прямоугольника
+   * \param position    левый нижний угол прямоугольника до поворота
+   * \param size        размер прямоугольника
+   * \return true - прямоугольник может попасть в видимую область
+   */
+  bool is_visible(const glm::vec2& position, const glm::vec2& size) const;
+
+ private:
+  void update() const;
+
+  glm::vec2 position{0};
+  float zoom{1};
+  float rotation{0};
+  glm::vec2 view_size{2};
+
+  mutable bool dirty{false};
+  mutable glm::mat4x4 view_projection{1};
+  mutable bounds view_bounds{glm::vec2{-1}, glm::vec2{1}};
+};
+}  // namespace render
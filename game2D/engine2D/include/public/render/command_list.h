@@ -0,0 +1,102 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <memory>
+namespace render
+{
+class texture2D;
+class shader_program;
+class camera2D;
+
+/*!
+ * \brief Список команд отрисовки потока
+ * Позволяет записывать спрайты кадра из нескольких рабочих потоков
+ * одновременно: каждый поток записывает в собственный список без
+ * блокировок, а поток отправки передает заполненные списки рендеру.
+ * Перед отрисовкой списки объединяются в порядке возрастания номеров, а
+ * элементы каждого списка - в порядке записи, после чего сортируются вместе
+ * с остальными элементами кадра. Итоговый порядок отрисовки не зависит от
+ * того, в каком порядке и с какой скоростью работали потоки.
+ * \note Порядок использования в кадре:
+ * - command_list::begin() - в потоке отправки, до запуска рабочих потоков
+ * - sprite2D::render(command_list&, ...) и command_list::add - в рабочем
+ * потоке, владеющем списком
+ * - command_list::submit() - в потоке отправки, после завершения рабочих
+ * потоков
+ * \note Видимость спрайтов проверяется по снимку камеры, сделанному в
+ * command_list::begin()
+ * \sa render::sprite2D::render(command_list& list, const render_settings&
+ * settings)
+ */
+class command_list
+{
+ public:
+  /*!
+   * \brief Инициализация списка
+   * \param id  номер списка, определяет порядок объединения списков кадра
+   * \note Номера списков, отправляемых в одном кадре, должны различаться
+   */
+  explicit command_list(unsigned int id);
+
+  /*!
+   * \brief Начало записи кадра
+   * Очищает список и сохраняет снимок камеры рендера
+   * \note Вызывается в потоке отправки, пока рабочие потоки не используют
+   * список
+   */
+  void begin();
+  /*!
+   * \brief Начало записи с заданной камерой
+   * \param camera  камера, по которой определяется видимость спрайтов
+   * \sa render::cached_layer
+   */
+  void begin(const camera2D& camera);
+
+  /*!
+   * \brief Запись спрайта
+   * \param program     шейдерная программа спрайта
+   * \param texture     текстура спрайта
+   * \param settings    свойства отрисовки
+   * \param frame       описатель области текстуры
+   * \note Спрайты вне видимой области камеры не записываются
+   */
+  void add(shader_program& program, const texture2D& texture,
+           const render_settings& settings, const frame_descriptor& frame);
+
+  /*!
+   * \brief Проверка видимости по снимку камеры
+   * \return true - спрайт может попасть в видимую область
+   * \note В отличие от камеры рендера безопасна в рабочих потоках
+   */
+  bool is_visible(const render_settings& settings) const;
+
+  /*!
+   * \brief Передача списка рендеру
+   * Список объединяется со списком отрисовки кадра при сбросе пакета
+   * \note Вызывается в потоке отправки. Список не должен изменяться до
+   * конца кадра
+   */
+  void submit();
+
+  unsigned int get_id() const { return id; }
+  /*!
+   * \brief Количество записанных элементов
+   */
+  size_t get_size() const;
+
+  ~command_list();
+
+  command_list(command_list&&);
+  command_list& operator=(command_list&&);
+
+  command_list(command_list&) = delete;
+  command_list& operator=(command_list&) = delete;
+
+ private:
+  unsigned int id;
+
+  friend class renderer;
+  friend class cached_layer;
+  struct list_impl;
+  std::unique_ptr<list_impl> impl{};
+};
+}  // namespace render
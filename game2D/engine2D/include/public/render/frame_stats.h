@@ -0,0 +1,38 @@
+#pragma once
+#include <array>
+
+namespace render
+{
+/*!
+ * \brief Статистика отрисовки кадра
+ * Счетчики, собираемые рендером в течение одного кадра.
+ * \sa core::engine::get_frame_stats()
+ */
+struct frame_stats
+{
+  unsigned int draw_calls{0};  ///< количество вызовов отрисовки
+  unsigned int state_calls{0};  ///< выполненные gl-вызовы смены состояния
+  unsigned int skipped_state_calls{
+      0};  ///< пропущенные избыточные gl-вызовы смены состояния
+  unsigned int drawn_sprites{
+      0};  ///< спрайты и экземпляры, попавшие в видимую область камеры
+  unsigned int culled_sprites{
+      0};  ///< спрайты и экземпляры, отброшенные вне видимой области
+  unsigned int buffer_waits{
+      0};  ///< ожидания освобождения сегмента потокового буфера
+
+  /*!
+   * \brief Количество проходов постобработки, время которых измеряется
+   */
+  static constexpr unsigned int max_timed_passes{8};
+  unsigned int post_passes{0};  ///< выполненные проходы постобработки
+  /*!
+   * \brief Время проходов постобработки в миллисекундах
+   * Измеряется в потоке, владеющем gl-контекстом. Без профилирования
+   * отражает только отправку команд
+   * \sa core::engine::set_post_process
+   */
+  std::array<float, max_timed_passes> post_pass_ms{};
+  float resolution_scale{1.f};  ///< масштаб динамического разрешения кадра
+};
+}  // namespace render
@@ -14,18 +14,45 @@ struct frame_descriptor
   glm::vec2 right_top_uv{1.f};  ///< координата правого верхнего угла области
 };
 
+/*!
+ * \brief Класс смешивания спрайта
+ * Определяет проход, в котором отрисовывается спрайт, и состояние смешивания
+ * и буфера глубины. Проходы выполняются в порядке объявления
+ * \note Цвет текстур хранится умноженным на альфа-канал
+ * \sa resources::resource_manager::load_texture2D
+ */
+enum class blend_mode : unsigned char
+{
+  opaque,      ///< непрозрачный: без смешивания, от ближних слоев к дальним
+  alpha_test,  ///< с отсечением прозрачных пикселей шейдером, без смешивания
+  translucent  ///< полупрозрачный: смешивание, от дальних слоев к ближним
+};
+
 /*!
  * \brief Найстройка отрисовки
  * Воспомогательная структура для отрсовки спрайтов
- * \note Координаты и размер задаются диапазоном [-1;1]
+ * \note Координаты и размер задаются в мировых координатах камеры. При
+ * камере по умолчанию они совпадают с диапазоном [-1;1]
+ * \sa render::camera2D
  */
 struct render_settings
 {
   glm::vec2 position{
       0};  ///< положение нижнего левого угла отрисовываемого объекта
   glm::vec2 size{1};  ///< размер объекта по ширине и высоте
-  int layer{0};       ///< слой отрисовки (макс. 50)
+  int layer{0};  ///< слой отрисовки (макс. 50), слои отрисовываются по
+                 ///< возрастанию
   float rotation{0};  ///< угол поворота объекта
+  blend_mode blend{blend_mode::translucent};  ///< класс смешивания
+  /*!
+   * \brief Глубина внутри слоя, [0; 1], 0 - ближе всего
+   * Задает порядок отрисовки спрайтов одного слоя: спрайты отрисовываются от
+   * дальних к ближним, и ближние перекрывают дальние
+   * \note Не влияет на значение глубины в буфере глубины: спрайты слоя
+   * имеют общую глубину
+   * \sa render::draw_list
+   */
+  float depth{0};
 };
 
 }  // namespace render
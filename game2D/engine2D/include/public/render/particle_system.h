@@ -0,0 +1,140 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <memory>
+#include <vector>
+namespace render
+{
+class texture2D;
+class shader_program;
+
+/*!
+ * \brief Описание излучателя частиц
+ * Данные, по которым излучатель рождает частицы и изменяет их в течение
+ * жизни. Размер, цвет и кадр частицы линейно меняются от рождения до
+ * смерти.
+ * \note Диапазоны задаются парами min/max, значение каждой новой частицы
+ * выбирается случайно внутри диапазона
+ */
+struct particle_emitter
+{
+  std::shared_ptr<texture2D> texture{};  ///< текстура частиц
+  /// кадры анимации частицы за время жизни, пустой - вся текстура
+  std::vector<frame_descriptor> frames{};
+
+  glm::vec2 position{0};  ///< центр области рождения
+  glm::vec2 area{0};      ///< размер области рождения
+  float rate{0};          ///< частиц в секунду, 0 - только вспышки
+
+  glm::vec2 lifetime{1, 1};      ///< время жизни в секундах (min, max)
+  glm::vec2 velocity_min{0};     ///< начальная скорость, нижняя граница
+  glm::vec2 velocity_max{0};     ///< начальная скорость, верхняя граница
+  glm::vec2 acceleration{0};     ///< ускорение, например гравитация
+  glm::vec2 size{0.02f, 0.02f};  ///< размер при рождении и смерти
+  glm::vec4 color_begin{1};      ///< цвет при рождении
+  glm::vec4 color_end{1};        ///< цвет при смерти
+
+  int layer{0};
+  blend_mode blend{blend_mode::translucent};
+  unsigned int capacity{10000};  ///< наибольшее число живых частиц
+};
+
+/*!
+ * \brief Система частиц
+ * Набор излучателей, частицы которых хранятся в заранее выделенных пулах
+ * в виде отдельных массивов по каждому свойству (SoA): положение, скорость,
+ * время жизни, размер, цвет и кадр. Обновление обрабатывает частицы по
+ * четыре векторными инструкциями и может разделяться между рабочими
+ * потоками.
+ * Частицы излучателей с общими текстурой, слоем и классом смешивания
+ * отрисовываются одним инстансным вызовом.
+ * \note Отрисовка требует инстансный шейдер render::sprite_instances с
+ * цветом экземпляра:
+ * - location 4 - vec4, цвет экземпляра, умножается на цвет текстуры
+ * \note Положение, размер и скорость задаются в мировых координатах
+ * \sa res/shaders/instanced_shader.vert
+ * \sa res/shaders/particle_shader.frag
+ */
+class particle_system
+{
+ public:
+  /*!
+   * \brief Инициализация системы
+   * \param program инстансная шейдерная программа частиц, nullptr -
+   * частицы только моделируются и не отрисовываются
+   * \param workers количество рабочих потоков обновления, 0 - обновление
+   * выполняется вызывающим потоком
+   */
+  explicit particle_system(std::shared_ptr<shader_program> program,
+                           unsigned int workers = 0);
+
+  /*!
+   * \brief Добавление излучателя
+   * Выделяет пул частиц излучателя размером particle_emitter::capacity
+   * \return Номер излучателя
+   */
+  unsigned int add_emitter(const particle_emitter& emitter);
+  /*!
+   * \brief Описание излучателя
+   * Позволяет перемещать излучатель и менять его свойства между
+   * обновлениями. Новые значения применяются к новым частицам, кроме
+   * ускорения, размера и цвета, которые применяются ко всем частицам
+   * \note Изменение texture, frames и capacity не поддерживается
+   */
+  particle_emitter& get_emitter(unsigned int emitter);
+
+  /*!
+   * \brief Рождение частиц вне зависимости от частоты излучателя
+   * \param emitter номер излучателя
+   * \param count   количество частиц
+   * \note Частицы сверх емкости пула не рождаются
+   */
+  void burst(unsigned int emitter, unsigned int count);
+
+  /*!
+   * \brief Обновление частиц
+   * Рождает частицы излучателей, перемещает живые частицы, обновляет их
+   * размер, цвет и кадр и удаляет умершие
+   * \param duration    длительность кадра в миллисекундах
+   */
+  void update(double duration);
+
+  /*!
+   * \brief Отрисовка всех частиц
+   * Отправляет частицы в список отрисовки кадра по одной инстансной
+   * отрисовке на каждую группу излучателей с общими текстурой, слоем и
+   * классом смешивания
+   */
+  void render();
+
+  /*!
+   * \brief Удаление всех частиц
+   */
+  void clear();
+
+  /*!
+   * \brief Количество живых частиц всех излучателей
+   */
+  size_t get_count() const;
+  /*!
+   * \brief Количество живых частиц излучателя
+   */
+  size_t get_count(unsigned int emitter) const;
+  size_t get_emitter_count() const;
+
+  ~particle_system();
+
+  particle_system(particle_system&&);
+  particle_system& operator=(particle_system&&);
+
+  particle_system(particle_system&) = delete;
+  particle_system& operator=(particle_system&) = delete;
+
+ private:
+  std::shared_ptr<shader_program> program;
+
+  struct system_impl;
+  std::unique_ptr<system_impl> impl{};
+};
+}  // namespace render
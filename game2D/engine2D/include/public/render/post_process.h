@@ -0,0 +1,34 @@
+#pragma once
+#include <glm/vec4.hpp>
+#include <memory>
+namespace render
+{
+class shader_program;
+
+/*!
+ * \brief Проход постобработки
+ * Полноэкранный проход, читающий результат предыдущего прохода (для первого
+ * прохода - отрисованный кадр) и записывающий результат в промежуточную
+ * цель отрисовки. Последний проход записывает результат в кадр окна.
+ * \note Программа прохода использует атрибут и uniform-поля:
+ * - location 0 - vec2, вершина полноэкранного квада [0;1]
+ * - s_texture     - sampler2D, результат предыдущего прохода (блок 0)
+ * - s_texel       - vec2, размер текселя s_texture в координатах текстуры
+ * - s_parameters  - vec4, параметры прохода
+ * - s_scene       - sampler2D, отрисованный кадр (блок 1), только при
+ * scene_input
+ * \sa res/shaders/post_process.vert
+ * \sa core::engine::set_post_process
+ */
+struct post_process_pass
+{
+  std::shared_ptr<shader_program> program{};
+  /*!
+   * \brief Разрешение цели прохода относительно области отрисовки
+   * Например 0.5 или 0.25. Не учитывается для последнего прохода
+   */
+  float scale{1.f};
+  glm::vec4 parameters{0};  ///< значение s_parameters
+  bool scene_input{false};  ///< true - кадр передается в s_scene
+};
+}  // namespace render
@@ -1,14 +1,52 @@
 #pragma once
 #include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 #include <memory>
 #include <string>
 namespace render
 {
 class texture2D;
+class shader_program;
+
+/*!
+ * \brief Дескриптор uniform-поля
+ * Хранит расположение uniform-поля шейдерной программы, найденное один раз
+ * при загрузке. Тип T определяет тип значения поля и используемую
+ * gl-функцию загрузки.
+ * \note Поддерживаемые типы: int, float, glm::vec2, glm::vec4, glm::mat4x4
+ * \note Дескриптор действителен только для программы, которая его выдала:
+ * установка значения через дескриптор другой программы игнорируется
+ * \sa render::shader_program::get_uniform(const std::string& u_name)
+ */
+template <typename T>
+class uniform
+{
+ public:
+  uniform() = default;
+
+  /*!
+   * \brief Состояние дескриптора
+   * \return true - поле найдено в программе
+   */
+  bool is_valid() const { return location != -1; }
+
+ private:
+  friend class shader_program;
+  uniform(int location_, const void* owner_)
+      : location{location_}, owner{owner_}
+  {
+  }
+  int location{-1};
+  const void* owner{nullptr};  ///< данные программы, выдавшей дескриптор
+};
 
 /*!
  * \brief Шейдерная программа
  * Класс представляет собой абстракцию вокруг gl-программы отрисовки.
+ * После компоновки программа один раз считывает список активных uniform-полей
+ * и атрибутов и хранит их расположение, а также последнее загруженное
+ * значение каждого uniform-поля.
  * \note Взаимодействует только с шейдерами, написанными на языке GLSL 300 es
  */
 class shader_program
@@ -43,16 +81,84 @@ class shader_program
 
   ~shader_program();
 
+  /*!
+   * \brief Поиск uniform-поля
+   * \param u_name  имя uniform-поля в шейдере
+   * \return Дескриптор поля. Если поле не найдено, возвращается
+   * недействительный дескриптор, а в log выводится сообщение
+   * \note Используйте при загрузке ресурсов, сохраняя дескриптор для
+   * последующих вызовов shader_program::set
+   */
+  template <typename T>
+  uniform<T> get_uniform(const std::string& u_name) const
+  {
+    return uniform<T>{find_uniform(u_name), impl.get()};
+  }
+
+  /*!
+   * \brief Расположение входного атрибута
+   * \param a_name  имя атрибута в вершинном шейдере
+   * \return Номер атрибута, -1 - атрибут не найден
+   */
+  int get_attribute_location(const std::string& a_name) const;
+
+  /*!
+   * \brief Проверка принадлежности дескриптора программе
+   * \return true - дескриптор выдан этой программой
+   */
+  template <typename T>
+  bool owns(const uniform<T>& handle) const
+  {
+    return handle.owner == impl.get();
+  }
+
+  /*!
+   * \brief Связывание uniform-блока с точкой привязки
+   * Программа читает значения полей блока из uniform-буфера, привязанного к
+   * точке binding
+   * \param block_name  имя uniform-блока в шейдере
+   * \param binding     номер точки привязки
+   * \return false - блок не найден в программе, в log выводится сообщение
+   * \note Блок frame_data связывается с точкой привязки данных кадра
+   * автоматически при компоновке программы
+   * \sa render::renderer::frame_block_name
+   */
+  bool bind_uniform_block(const std::string& block_name, unsigned int binding);
+  /*!
+   * \brief Наличие uniform-блока
+   * \param block_name  имя uniform-блока в шейдере
+   * \return true - программа использует блок
+   */
+  bool has_uniform_block(const std::string& block_name) const;
+
+  /*!
+   * \name Установка uniform-поля по дескриптору
+   * Активирует программу и загружает значение, если оно отличается от
+   * последнего загруженного.
+   * \param handle  дескриптор uniform-поля
+   * \param value   значение для заполнения
+   * \return false - дескриптор недействителен
+   */
+  ///@{
+  bool set(uniform<int> handle, int value);
+  bool set(uniform<float> handle, float value);
+  bool set(uniform<glm::vec2> handle, const glm::vec2& value);
+  bool set(uniform<glm::vec4> handle, const glm::vec4& value);
+  bool set(uniform<glm::mat4x4> handle, const glm::mat4x4& value);
+  ///@}
+
   /*!
    * \brief Установка uniform-поля
    * \param u_name  имя uniform-поля в шейдере
    * \param value   значение для заполнения
    * \note для указания значения для типа sampler2D необходима вписать индекс
    * текстурного буфера, к кторому привязана текстура.
+   * \note Поиск поля по имени выполняется при каждом вызове. Для частых
+   * вызовов используйте shader_program::get_uniform
    * \return
    * \sa render::texture2D
    */
-  bool set_uniform(std::string u_name, int value);
+  bool set_uniform(const std::string& u_name, int value);
 
   /*!
    * \brief Установка uniform-поля
@@ -60,12 +166,17 @@ class shader_program
    * \param value   значение для заполнения
    * \return
    */
-  bool set_uniform(std::string u_name, const glm::mat4x4& value);
+  bool set_uniform(const std::string& u_name, const glm::mat4x4& value);
 
   shader_program(shader_program&) = delete;
   shader_program& operator=(shader_program&) = delete;
 
  private:
+  int find_uniform(const std::string& u_name) const;
+  bool upload(int location, const void* value, unsigned int size);
+
+  friend class draw_list;
+
   struct sprogram_impl;
   std::unique_ptr<sprogram_impl> impl{nullptr};
 };
@@ -6,17 +6,19 @@ namespace render
 {
 class texture2D;
 class shader_program;
+class command_list;
 
-class index_buffer;
-class vertex_array;
-class vertex_buffer;
 /*!
  * \brief Спрайт
  * Представляет собой абстракцию спрайта для отрисовки.
+ * Спрайт не владеет gl-объектами: его вершины и текстурные координаты
+ * передаются в общий поток пакетного рендера при каждой отрисовке.
  * \note Отрисовка спрайта требует определенных имен uniform-полей в шейдере:
  * - s_model    - mat4, модельная матрица
  * - s_texture  - sampler2D, указатель на текстуру
  * - s_layer    - int, слой отрисовки
+ * - frame_data - uniform-блок данных кадра с матрицей вида-проекции
+ * камеры
  * \sa sprite2D::render(const render_settings& settings)
  */
 class sprite2D
@@ -44,6 +46,12 @@ class sprite2D
    * - s_model    - mat4, модельная матрица
    * - s_texture  - sampler2D, указатель на текстуру
    * - s_layer    - int, слой отрисовки
+   * - frame_data - uniform-блок данных кадра с матрицей вида-проекции
+   * камеры
+   * \note При включенной пакетной отрисовке (window_properties::sprite_batching)
+   * спрайт попадает в back-буфер в конце кадра: спрайты кадра сортируются по
+   * слою, программе и текстуре, и спрайты с одинаковыми слоем, программой и
+   * текстурой отрисовываются одним вызовом. Иначе спрайт отрисовывается сразу
    * \param settings    свойства отрисовки
    */
   void render(const render_settings& settings);
@@ -55,6 +63,8 @@ class sprite2D
    * - s_model    - mat4, модельная матрица
    * - s_texture  - sampler2D, указатель на текстуру
    * - s_layer    - int, слой отрисовки
+   * - frame_data - uniform-блок данных кадра с матрицей вида-проекции
+   * камеры
    * \param settings        свойства отрисовки
    * \param f_discriptor    описатель диапазона отрисовки в текстуре
    * f_discriptor указывает какую именно часть текстуры следует отрисовывать
@@ -64,6 +74,27 @@ class sprite2D
   void render(const render_settings& settings,
               const frame_descriptor& f_discriptor);
 
+  /*!
+   * \brief Запись спрайта в список команд потока
+   * Записывает спрайт с активным описателем области в список команд
+   * \param list        список команд вызывающего потока
+   * \param settings    свойства отрисовки
+   * \note Не изменяет спрайт, поэтому один спрайт может одновременно
+   * записываться несколькими потоками
+   * \sa render::command_list
+   */
+  void render(command_list& list, const render_settings& settings) const;
+  /*!
+   * \brief Запись области спрайта в список команд потока
+   * \param list            список команд вызывающего потока
+   * \param settings        свойства отрисовки
+   * \param f_discriptor    описатель диапазона отрисовки в текстуре
+   * \note В отличие от render(const render_settings&, const
+   * frame_descriptor&) активный описатель области не изменяется
+   */
+  void render(command_list& list, const render_settings& settings,
+              const frame_descriptor& f_discriptor) const;
+
   ~sprite2D();
 
   sprite2D(sprite2D&&);
@@ -86,8 +117,5 @@ class sprite2D
 
   std::shared_ptr<shader_program> program;
   std::shared_ptr<texture2D> texture;
-
-  struct sprite2D_impl;
-  std::unique_ptr<sprite2D_impl> impl{};
 };
 }  // namespace render
@@ -5,6 +5,7 @@
 namespace render
 {
 class sprite2D;
+class command_list;
 
 /*!
  * \brief Аниматор спрайта
@@ -33,8 +34,11 @@ class sprite_animator
   /*!
    * \brief Обновление  состояния анимации
    * \param duration    прошедшее время в миллисекундах
-   * \note За один вызов функция может перейти только на 1 кадр, не смотря на
-   * значение duration.
+   * \note За один вызов функция переходит через столько кадров, сколько
+   * помещается в duration
+   * \note Для большого количества анимированных объектов используйте
+   * render::animation_world, а для непрерывно проигрываемых анимаций -
+   * render::animated_instances
    */
   void update(double duration);
   /*!
@@ -45,6 +49,14 @@ class sprite_animator
    * \sa render::sprite2D::render(const render_settings& settings)
    */
   void render(const render_settings& settings);
+  /*!
+   * \brief Запись активного фрейма в список команд потока
+   * \param list        список команд вызывающего потока
+   * \param settings    параметры отрисовки
+   * \note Видимость определяется по снимку камеры списка
+   * \sa render::command_list
+   */
+  void render(command_list& list, const render_settings& settings);
 
   /*!
    * \brief Добавление фрейма в конец списка кадров
@@ -61,6 +73,17 @@ class sprite_animator
    */
   void clear_frames();
 
+  /*!
+   * \brief Обновление анимации вне видимой области
+   * \param enabled   true - кадры переключаются всегда, false - пока спрайт
+   * находится вне видимой области камеры, переключение кадров пропускается
+   * \note Видимость определяется по параметрам последнего вызова
+   * sprite_animator::render(const render_settings& settings). Пропущенное
+   * время накапливается, поэтому фаза анимации сохраняется
+   * \sa render::camera2D
+   */
+  void set_offscreen_updates(bool enabled) { offscreen_updates = enabled; }
+
   /*!
    * \brief Возврат активного кадра
    * \return Активный кадр анимации
@@ -85,5 +108,9 @@ class sprite_animator
   size_t current_frame_index{0};
   double current_duration{0};
   double summary_duration{0};
+  double loop_duration{0};  ///< период повтора, 0 - есть кадр удержания
+  bool has_hold_frame{false};
+  bool offscreen_updates{true};
+  bool visible{true};
 };
 }  // namespace render
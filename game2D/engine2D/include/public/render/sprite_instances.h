@@ -0,0 +1,101 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <memory>
+#include <string>
+#include <vector>
+namespace render
+{
+class texture2D;
+class shader_program;
+
+/*!
+ * \brief Набор экземпляров спрайта
+ * Отрисовывает множество копий одной текстуры (или областей одного атласа)
+ * одним инстансным вызовом. Все экземпляры используют общий единичный квад,
+ * а положение, размер, поворот, слой и область текстуры каждого экземпляра
+ * передаются в буфер экземпляров и обрабатываются вершинным шейдером.
+ * \note Отрисовка требует шейдер с атрибутами экземпляров:
+ * - location 0 - vec2, вершина единичного квада
+ * - location 1 - vec4, положение (xy) и размер (zw)
+ * - location 2 - vec2, угол поворота в градусах (x) и слой (y)
+ * - location 3 - vec4, левый нижний (xy) и правый верхний (zw) углы области
+ * текстуры
+ * - location 4 - vec4, цвет экземпляра (для наборов всегда белый)
+ * и uniform-поля:
+ * - s_texture         - sampler2D, указатель на текстуру
+ * - frame_data - uniform-блок данных кадра с матрицей вида-проекции
+ * камеры
+ * \note Экземпляры вне видимой области камеры отбрасываются при отрисовке
+ * \sa res/shaders/instanced_shader.vert
+ */
+class sprite_instances
+{
+ public:
+  /*!
+   * \brief Инициализация набора
+   * \param texture     текстура экземпляров
+   * \param subtexture  подтекстура по умолчанию
+   * \param program     инстансная шейдерная программа
+   * \note Если texture не содержит подтекстуры с именем subtexture, то
+   * используется вся текстура
+   */
+  sprite_instances(std::shared_ptr<texture2D> texture, std::string subtexture,
+                   std::shared_ptr<shader_program> program);
+
+  /*!
+   * \brief Добавление экземпляра с подтекстурой по умолчанию
+   * \param settings    свойства отрисовки экземпляра
+   */
+  void add(const render_settings& settings);
+
+  /*!
+   * \brief Добавление экземпляра
+   * \param settings        свойства отрисовки экземпляра
+   * \param f_discriptor    описатель области текстуры экземпляра
+   */
+  void add(const render_settings& settings,
+           const frame_descriptor& f_discriptor);
+
+  /*!
+   * \brief Установка класса смешивания набора
+   * \note Класс смешивания общий для всех экземпляров набора
+   */
+  void set_blend(blend_mode blend);
+
+  /*!
+   * \brief Удаление всех экземпляров
+   */
+  void clear();
+
+  /*!
+   * \brief Возвращает количество экземпляров
+   */
+  size_t get_count() const;
+
+  /*!
+   * \brief Отрисовка всех экземпляров в back-буфер
+   * Копирует данные экземпляров в список отрисовки кадра. При сбросе списка
+   * они загружаются в буфер экземпляров и отрисовываются одним вызовом.
+   * \note В списке отрисовки набор сортируется по наименьшему слою своих
+   * экземпляров
+   */
+  void render();
+
+  ~sprite_instances();
+
+  sprite_instances(sprite_instances&&);
+  sprite_instances& operator=(sprite_instances&&);
+
+  sprite_instances(sprite_instances&) = delete;
+  sprite_instances& operator=(sprite_instances&) = delete;
+
+ private:
+  frame_descriptor frame;
+
+  std::shared_ptr<shader_program> program;
+  std::shared_ptr<texture2D> texture;
+
+  struct instances_impl;
+  std::unique_ptr<instances_impl> impl{};
+};
+}  // namespace render
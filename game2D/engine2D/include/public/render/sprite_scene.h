@@ -0,0 +1,105 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <glm/vec4.hpp>
+#include <memory>
+#include <vector>
+namespace render
+{
+class texture2D;
+class shader_program;
+
+/*!
+ * \brief Сохраняемая сцена спрайтов
+ * Спрайты создаются один раз и существуют до удаления, а игра изменяет
+ * только их поля через постоянные номера. Данные экземпляров хранятся в
+ * буфере видеокарты, и при отрисовке загружаются только диапазоны
+ * изменившихся спрайтов, поэтому стоимость кадра зависит от количества
+ * изменений, а не от количества спрайтов.
+ * \note Отрисовка требует тех же атрибутов и полей шейдера, что и
+ * render::sprite_instances
+ * \note Сцена отрисовывается целиком одним инстансным вызовом, без
+ * отбрасывания спрайтов вне видимой области камеры
+ * \sa res/shaders/instanced_shader.vert
+ */
+class sprite_scene
+{
+ public:
+  using handle = unsigned int;
+
+  /*!
+   * \brief Инициализация сцены
+   * \param texture     текстура (атлас) спрайтов сцены
+   * \param program     инстансная шейдерная программа
+   */
+  sprite_scene(std::shared_ptr<texture2D> texture,
+               std::shared_ptr<shader_program> program);
+
+  /*!
+   * \brief Создание спрайта
+   * \param settings    свойства отрисовки
+   * \param frame       область текстуры
+   * \param color       цвет, умножается на цвет текстуры
+   * \return Номер спрайта
+   * \note Номер удаленного спрайта может быть выдан новому спрайту
+   */
+  handle create(const render_settings& settings,
+                const frame_descriptor& frame = frame_descriptor{},
+                const glm::vec4& color = glm::vec4{1.f});
+  /*!
+   * \brief Удаление спрайта
+   * \note Последний спрайт сцены переносится на место удаленного, поэтому
+   * удаление загружает данные одного спрайта. Удаленный номер
+   * недействителен до повторной выдачи функцией create
+   */
+  void destroy(handle sprite);
+
+  /// \name Изменение полей спрайта
+  ///@{
+  void set_settings(handle sprite, const render_settings& settings);
+  void set_position(handle sprite, const glm::vec2& position);
+  void set_frame(handle sprite, const frame_descriptor& frame);
+  void set_color(handle sprite, const glm::vec4& color);
+  ///@}
+  const render_settings& get_settings(handle sprite) const;
+
+  /*!
+   * \brief Установка класса смешивания сцены
+   */
+  void set_blend(blend_mode blend);
+
+  /*!
+   * \brief Удаление всех спрайтов
+   */
+  void clear();
+
+  size_t get_count() const;
+  /*!
+   * \brief Количество спрайтов, изменившихся после последней отрисовки
+   */
+  size_t get_dirty_count() const;
+
+  /*!
+   * \brief Отрисовка сцены
+   * Отправляет команду, которая загружает изменившиеся диапазоны спрайтов и
+   * отрисовывает всю сцену
+   * \note В списке отрисовки сцена сортируется по наименьшему слою,
+   * заданному ее спрайтам после последней очистки
+   */
+  void render();
+
+  ~sprite_scene();
+
+  sprite_scene(sprite_scene&&);
+  sprite_scene& operator=(sprite_scene&&);
+
+  sprite_scene(sprite_scene&) = delete;
+  sprite_scene& operator=(sprite_scene&) = delete;
+
+ private:
+  std::shared_ptr<shader_program> program;
+  std::shared_ptr<texture2D> texture;
+
+  struct scene_impl;
+  std::unique_ptr<scene_impl> impl{};
+};
+}  // namespace render
@@ -1,12 +1,17 @@
 #pragma once
 #include <render/frame_structures.h>
 #include <glm/vec2.hpp>
+#include <cstddef>
 #include <map>
 #include <string>
+#include <vector>
 namespace render
 {
 /*!
  * \brief Цеветовые модели
+ * \note Форматы etc2_* и eac_* являются сжатыми форматами, поддержка которых
+ * обязательна для GLES 3.0. Данные таких текстур загружаются блоками 4x4
+ * тексела
  */
 enum class color_format
 {
@@ -15,7 +20,14 @@ enum class color_format
   blue,
   alpha,
   rgb,
-  rgba
+  rgba,
+  rgb565,       ///< 16 бит на тексель: 5-6-5
+  rgba4444,     ///< 16 бит на тексель: 4-4-4-4
+  etc2_rgb,     ///< ETC2, 4 бита на тексель
+  etc2_rgb_a1,  ///< ETC2 с однобитной прозрачностью, 4 бита на тексель
+  etc2_rgba,    ///< ETC2 с EAC-прозрачностью, 8 бит на тексель
+  eac_r11,      ///< EAC, один канал, 4 бита на тексель
+  eac_rg11      ///< EAC, два канала, 8 бит на тексель
 };
 
 enum class texture_filter
@@ -40,6 +52,17 @@ enum class wrap_mode
 class texture2D
 {
  public:
+  /*!
+   * \brief Уровень детализации текстуры
+   */
+  struct level
+  {
+    int width;         ///< ширина уровня
+    int height;        ///< высота уровня
+    const void* data;  ///< данные уровня
+    size_t size;       ///< размер данных в байтах
+  };
+
   /*!
    * \brief Инициализация текстуры
    * \param width       ширина текстуры
@@ -53,6 +76,37 @@ class texture2D
             const texture_filter filter = texture_filter::linear,
             const wrap_mode mode = wrap_mode::clamp_to_edge);
 
+  /*!
+   * \brief Инициализация текстуры готовыми уровнями детализации
+   * Используется для сжатых текстур, для которых уровни детализации не могут
+   * быть построены видеокартой
+   * \param levels      уровни детализации, начиная с самого крупного
+   * \param format      цветовая модель
+   * \param filter      режим фильтрации текстуры при рендере
+   * \param wrapMode    поведение текстуры при отрисовке
+   * \param generate_mipmaps    построить уровни детализации по первому
+   * уровню и использовать их при фильтрации. Игнорируется для сжатых
+   * текстур и нескольких уровней
+   */
+  texture2D(const std::vector<level>& levels, const color_format format,
+            const texture_filter filter = texture_filter::linear,
+            const wrap_mode mode = wrap_mode::clamp_to_edge,
+            bool generate_mipmaps = false);
+
+  /*!
+   * \brief Размер изображения в заданном формате
+   * \param width   ширина изображения
+   * \param height  высота изображения
+   * \param format  цветовая модель
+   * \return Размер данных в байтах
+   */
+  static size_t get_image_size(int width, int height, color_format format);
+
+  /*!
+   * \brief Сжатость формата
+   * \return true - формат является сжатым блочным форматом
+   */
+  static bool is_compressed(color_format format);
   /*!
    * \brief Сделать текстуру активной
    * Привязывает текстуру к активному текстурному буферу.
@@ -125,7 +179,12 @@ class texture2D
   static void active_texture(unsigned int offset);
 
  private:
+  friend class draw_list;
+
   void restore(int width, int height, const void* data, color_format format);
+  void upload(const std::vector<level>& levels, color_format format,
+              texture_filter filter, wrap_mode mode,
+              bool generate_mipmaps = false);
   unsigned int id{0};
   int height{0};
   int width{0};
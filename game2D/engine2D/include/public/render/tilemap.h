@@ -0,0 +1,151 @@
+#pragma once
+#include <render/frame_structures.h>
+#include <glm/vec2.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+namespace render
+{
+class texture2D;
+class shader_program;
+
+/*!
+ * \brief Тайловая карта
+ * Прямоугольная сетка тайлов, каждый из которых ссылается на область
+ * текстурного атласа из набора тайлов карты. Карта разбивается на квадратные
+ * чанки, вершины каждого чанка один раз загружаются в собственный
+ * статический вершинный буфер. В кадре отрисовываются только чанки,
+ * попадающие в видимую область камеры, одним вызовом на чанк.
+ * При изменении тайла пересобирается только содержащий его чанк.
+ * \note Отрисовка требует тех же uniform-полей, что и render::sprite2D:
+ * - s_model    - mat4, модельная матрица, задает положение карты
+ * - s_texture  - sampler2D, указатель на текстуру
+ * - s_layer    - int, слой отрисовки
+ * - frame_data - uniform-блок данных кадра с матрицей вида-проекции
+ * камеры
+ * \note Тайлы нумеруются от левого нижнего угла карты, строка 0 - нижняя
+ * \sa res/shaders/test_shader.vert
+ */
+class tilemap
+{
+ public:
+  static constexpr int empty_tile{-1};  ///< тайл без изображения
+
+  /*!
+   * \brief Инициализация карты
+   * \param texture     текстура атласа тайлов
+   * \param program     шейдерная программа карты
+   * \param columns     количество тайлов по горизонтали
+   * \param rows        количество тайлов по вертикали
+   * \param tile_size   размер тайла в мировых координатах
+   * \param chunk_size  размер стороны чанка в тайлах
+   * \note Все тайлы новой карты пусты
+   */
+  tilemap(std::shared_ptr<texture2D> texture,
+          std::shared_ptr<shader_program> program, unsigned int columns,
+          unsigned int rows, const glm::vec2& tile_size,
+          unsigned int chunk_size = 16);
+
+  /*!
+   * \brief Добавление тайла в набор
+   * \param subtexture  имя подтекстуры атласа
+   * \return Номер тайла в наборе
+   * \note Если атлас не содержит подтекстуры с именем subtexture, то
+   * используется вся текстура
+   */
+  int add_tile(const std::string& subtexture);
+  /*!
+   * \brief Добавление тайла в набор
+   * \param frame   описатель области атласа
+   * \return Номер тайла в наборе
+   */
+  int add_tile(const frame_descriptor& frame);
+
+  /*!
+   * \brief Заполнение всей карты
+   * \param tiles   номера тайлов по строкам снизу вверх, размер columns * rows
+   * \return false - размер tiles не совпадает с размером карты, или номер
+   * тайла не входит в набор и не равен empty_tile. Карта не изменяется
+   */
+  bool set_tiles(const std::vector<int>& tiles);
+  /*!
+   * \brief Замена тайла
+   * Помечает чанк, содержащий тайл, для пересборки перед следующей
+   * отрисовкой
+   * \param column  столбец тайла
+   * \param row     строка тайла
+   * \param tile    номер тайла в наборе или tilemap::empty_tile
+   * \note Тайлы вне карты и неизвестные номера игнорируются
+   */
+  void set_tile(unsigned int column, unsigned int row, int tile);
+  /*!
+   * \brief Номер тайла
+   * \return Номер тайла в наборе, tilemap::empty_tile - тайл пуст или
+   * находится вне карты
+   */
+  int get_tile(unsigned int column, unsigned int row) const;
+
+  /*!
+   * \brief Установка положения левого нижнего угла карты
+   * \note Положение передается в s_model и не требует пересборки чанков
+   */
+  void set_position(const glm::vec2& position_) { position = position_; }
+  /*!
+   * \brief Установка слоя отрисовки карты
+   */
+  void set_layer(int layer_) { layer = layer_; }
+  /*!
+   * \brief Установка класса смешивания карты
+   * \note Карта без прозрачных тайлов отрисовывается дешевле как
+   * blend_mode::opaque
+   */
+  void set_blend(blend_mode blend_) { blend = blend_; }
+
+  const glm::vec2& get_position() const { return position; }
+  int get_layer() const { return layer; }
+  blend_mode get_blend() const { return blend; }
+  unsigned int get_columns() const { return columns; }
+  unsigned int get_rows() const { return rows; }
+  const glm::vec2& get_tile_size() const { return tile_size; }
+
+  /*!
+   * \brief Отрисовка видимых чанков
+   * Отбрасывает чанки вне видимой области камеры и отправляет отрисовку
+   * остальных в список отрисовки кадра одной командой со слоем карты.
+   * Измененные видимые чанки пересобираются при вызове, а их вершины
+   * загружаются в буферы при выполнении команды.
+   * \note Карта должна существовать до сброса списка отрисовки
+   */
+  void render();
+
+  ~tilemap();
+
+  tilemap(tilemap&&);
+  tilemap& operator=(tilemap&&);
+
+  tilemap(tilemap&) = delete;
+  tilemap& operator=(tilemap&) = delete;
+
+ private:
+  /*!
+   * \brief Сборка вершин чанка
+   * Вершины добавляются в загрузки кадра и передаются команде отрисовки
+   */
+  void build_chunk(unsigned int chunk);
+
+  unsigned int columns;
+  unsigned int rows;
+  glm::vec2 tile_size;
+  unsigned int chunk_size;
+
+  glm::vec2 position{0};
+  int layer{0};
+  blend_mode blend{blend_mode::translucent};
+
+  std::shared_ptr<shader_program> program;
+  std::shared_ptr<texture2D> texture;
+
+  struct tilemap_impl;
+  std::unique_ptr<tilemap_impl> impl{};
+};
+}  // namespace render
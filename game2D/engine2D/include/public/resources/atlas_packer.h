@@ -0,0 +1,123 @@
+#pragma once
+#include <render/texture2D.h>
+#include <memory>
+#include <string>
+#include <vector>
+namespace resources
+{
+/*!
+ * \brief Упаковщик текстурного атласа
+ * Объединяет множество изображений в одну или несколько больших текстур
+ * (страниц) алгоритмом skyline bottom-left. Каждое изображение
+ * регистрируется на своей странице как подтекстура со своим именем, поэтому
+ * спрайты из разных файлов используют общую текстуру и отрисовываются одной
+ * серией пакетного рендера.
+ * Между изображениями оставляется отступ, а крайние пиксели изображения
+ * дублируются наружу (extrusion), что исключает просачивание соседних
+ * изображений при линейной фильтрации.
+ * \note Все изображения хранятся в формате rgba
+ * \sa resources::resource_manager::load_packed_atlas
+ */
+class atlas_packer
+{
+ public:
+  /*!
+   * \brief Расположение изображения в атласе
+   */
+  struct placement
+  {
+    std::string name;  ///< имя изображения
+    unsigned int page{0};  ///< номер страницы
+    unsigned int x{0};  ///< смещение левого нижнего угла по горизонтали
+    unsigned int y{0};  ///< смещение левого нижнего угла по вертикали
+    unsigned int width{0};
+    unsigned int height{0};
+  };
+
+  /*!
+   * \brief Инициализация упаковщика
+   * \param page_width      ширина страницы в пикселях
+   * \param page_height     высота страницы в пикселях
+   * \param padding         пустой отступ между изображениями в пикселях
+   * \param extrude         количество дублируемых крайних пикселей
+   */
+  atlas_packer(unsigned int page_width = 2048, unsigned int page_height = 2048,
+               unsigned int padding = 2, unsigned int extrude = 1);
+
+  /*!
+   * \brief Добавление изображения
+   * \param name        имя подтекстуры
+   * \param width       ширина изображения
+   * \param height      высота изображения
+   * \param channels    количество каналов: 1 - 4
+   * \param data        пиксели изображения, строки снизу вверх
+   * \return false - изображение не помещается на страницу
+   * \note Данные копируются, data могут быть удалены после вызова
+   */
+  bool add_image(const std::string& name, unsigned int width,
+                 unsigned int height, unsigned int channels,
+                 const unsigned char* data);
+
+  /*!
+   * \brief Упаковка изображений и создание страниц
+   * Изображения упаковываются в порядке убывания высоты. Для каждой страницы
+   * создается текстура с подтекстурами добавленных изображений
+   * \param filter  режим фильтрации страниц
+   * \return Созданные страницы атласа
+   * \note Добавленные изображения удаляются из упаковщика
+   */
+  std::vector<std::shared_ptr<render::texture2D>> build(
+      render::texture_filter filter = render::texture_filter::linear);
+
+  /*!
+   * \brief Расположение изображений последней упаковки
+   */
+  const std::vector<placement>& get_placements() const { return placements; }
+
+  /*!
+   * \brief Количество добавленных изображений
+   */
+  size_t get_count() const { return images.size(); }
+
+ private:
+  struct image
+  {
+    std::string name;
+    unsigned int width;
+    unsigned int height;
+    std::vector<unsigned char> pixels;  ///< rgba
+  };
+
+  /*!
+   * \brief Линия горизонта skyline
+   */
+  struct skyline_node
+  {
+    unsigned int x;
+    unsigned int y;
+    unsigned int width;
+  };
+
+  /*!
+   * \brief Поиск места на странице
+   * \return false - прямоугольник не помещается на страницу
+   */
+  bool find_position(const std::vector<skyline_node>& skyline,
+                     unsigned int width, unsigned int height,
+                     size_t& node_index, unsigned int& x,
+                     unsigned int& y) const;
+  void add_skyline_level(std::vector<skyline_node>& skyline, size_t node_index,
+                         unsigned int x, unsigned int y, unsigned int width,
+                         unsigned int height) const;
+  void copy_image(std::vector<unsigned char>& page, const image& source,
+                  unsigned int x, unsigned int y) const;
+
+  unsigned int page_width;
+  unsigned int page_height;
+  unsigned int padding;
+  unsigned int extrude;
+
+  std::vector<image> images{};
+  std::vector<placement> placements{};
+};
+}  // namespace resources
@@ -62,6 +62,9 @@ class resource_manager
 
   /*!
    * \brief Загрузка 2D-текстуры из файла
+   * Текстура загружается в формате rgba. Черные пиксели (цветовой ключ)
+   * становятся прозрачными, а цвет остальных пикселей умножается на
+   * альфа-канал, как того требует смешивание render::blend_mode::translucent
    * \param texture_name    мя, идентифицирующее объект
    * \param filepath        относительный путь к текстуре
    * \return Загруженная тексткура, nullptr - объект не загружен
@@ -69,6 +72,43 @@ class resource_manager
   std::shared_ptr<render::texture2D> load_texture2D(
       const std::string& texture_name, const std::string& filepath);
 
+  /*!
+   * \brief Загрузка 2D-текстуры из файла с преобразованием формата
+   * Преобразует пиксели изображения в заданную цветовую модель перед
+   * загрузкой в видеопамять. Форматы rgb565 и rgba4444 занимают вдвое меньше
+   * памяти, чем rgba, и подходят для пиксельной графики
+   * \note Пиксели форматов с альфа-каналом подготавливаются к смешиванию так
+   * же, как в load_texture2D(const std::string&, const std::string&)
+   * \param texture_name    имя, идентифицирующее объект
+   * \param filepath        относительный путь к текстуре
+   * \param format          цветовая модель текстуры: rgb, rgba, rgb565 или
+   * rgba4444
+   * \return Загруженная тексткура, nullptr - объект не загружен
+   */
+  std::shared_ptr<render::texture2D> load_texture2D(
+      const std::string& texture_name, const std::string& filepath,
+      render::color_format format);
+
+  /*!
+   * \brief Загрузка 2D-текстуры из KTX-файла
+   * Загружает текстуру из контейнера KTX 1.1 или KTX 2.0 вместе с
+   * уровнями детализации. Поддерживаются сжатые форматы ETC2/EAC и несжатые
+   * форматы rgb, rgba, rgb565 и rgba4444.
+   * \param texture_name    имя, идентифицирующее объект
+   * \param filepath        относительный путь к KTX-файлу
+   * \param filter          режим фильтрации текстуры
+   * \return Загруженная тексткура, nullptr - объект не загружен
+   * \note Несжатые текстуры, записанные сверху вниз, переворачиваются при
+   * загрузке. Сжатые текстуры необходимо записывать с началом координат в
+   * левом нижнем углу (KTXorientation T=u), иначе они загружаются без
+   * переворота
+   * \note Для файла без уровней детализации (их количество в заголовке
+   * равно 0) уровни несжатой текстуры строятся видеокартой
+   */
+  std::shared_ptr<render::texture2D> load_ktx(
+      const std::string& texture_name, const std::string& filepath,
+      render::texture_filter filter = render::texture_filter::linear);
+
   /*!
    * \brief Возврат загруженной текстуры по имени
    * \param texture_name    имя, идентифицирующее объект
@@ -94,13 +134,40 @@ class resource_manager
       std::vector<std::string> subtexture_names, unsigned int frame_width,
       unsigned int frame_height);
 
+  /*!
+   * \brief Загрузка изображений в общий упакованный атлас
+   * Загружает изображения из файлов и упаковывает их в одну или несколько
+   * страниц-текстур с именами atlas_name + "_" + номер страницы. Каждое
+   * изображение становится подтекстурой своей страницы с именем изображения.
+   * Спрайты, загруженные по имени изображения, используют общую страницу и
+   * отрисовываются одной серией пакетного рендера.
+   * \note Пиксели изображений подготавливаются к смешиванию так же, как в
+   * load_texture2D(const std::string&, const std::string&)
+   * \param atlas_name      имя атласа
+   * \param images          пары: имя изображения - относительный путь к файлу
+   * \param page_size       ширина и высота страницы в пикселях
+   * \return Страницы атласа, пустой список - ни одно изображение не загружено
+   * \note Страницы хранятся вместе с текстурами
+   * \sa resources::atlas_packer
+   * \sa resources::resource_manager::load_sprite
+   */
+  std::vector<std::shared_ptr<render::texture2D>> load_packed_atlas(
+      const std::string& atlas_name,
+      const std::vector<std::pair<std::string, std::string>>& images,
+      unsigned int page_size = 2048);
+
   /*!
    * \brief Загрузка спрайта из загруженных ресурсов
    * Создает спрайт на основе уже загруженной текстуры и программы
    * \param sprite_name имя, идентифицирующее объект
-   * \param texture     имя загруденной текстуры
+   * \param texture     имя загруденной текстуры или изображения упакованного
+   * атласа
    * \param program     имя загруженной шейдерной программы
    * \param subtexture  имя подтекстуры для инициализации спрайта
+   * \note Если texture является именем изображения упакованного атласа, а
+   * subtexture не указана, спрайт использует область изображения на странице
+   * атласа
+   * \sa resources::resource_manager::load_packed_atlas
    * \return Созданный спрайт, nullptr - объект не загружен
    */
   std::shared_ptr<render::sprite2D> load_sprite(
@@ -142,6 +209,9 @@ class resource_manager
 
   std::map<std::string, std::shared_ptr<render::texture2D>> texture_map;
 
+  /// имя изображения упакованного атласа - имя страницы
+  std::map<std::string, std::string> packed_image_map;
+
   std::map<std::string, std::shared_ptr<sound::wav_sound>> wav_map;
 
   std::map<std::string, std::shared_ptr<render::sprite2D>> sprite_map;
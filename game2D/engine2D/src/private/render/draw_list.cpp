@@ -0,0 +1,233 @@
+#include "render/draw_list.h"
+#include <algorithm>
+#include <array>
+#include "render/sprogram_impl.h"
+#include "render/texture2D.h"
+namespace render
+{
+std::uint64_t draw_list::make_key(int layer, blend_mode blend, float depth,
+                                  unsigned int program, unsigned int texture,
+                                  std::uint64_t sequence)
+{
+  std::uint64_t layer_bits{
+      static_cast<std::uint64_t>(std::clamp(layer + 128, 0, 255))};
+  std::uint64_t depth_bits{static_cast<std::uint64_t>(
+      std::clamp(depth, 0.f, 1.f) * 1023.f + 0.5f)};
+  // opaque items go front-to-back, so the depth test rejects hidden pixels
+  if (blend == blend_mode::opaque) layer_bits = 255 - layer_bits;
+  // sprites of one layer share the depth value, so inside a layer every
+  // class goes back-to-front and nearer sprites are drawn over
+  depth_bits = 1023 - depth_bits;
+
+  return (static_cast<std::uint64_t>(blend) & 0x3) << 62 | layer_bits << 54 |
+         depth_bits << 44 | (static_cast<std::uint64_t>(program) & 0x3ff) << 34 |
+         (static_cast<std::uint64_t>(texture) & 0x3fff) << sequence_bits |
+         (sequence & ((std::uint64_t{1} << sequence_bits) - 1));
+}
+
+unsigned int draw_list::program_id(const shader_program& program)
+{
+  return program.impl->id;
+}
+unsigned int draw_list::texture_id(const texture2D& texture)
+{
+  return texture.id;
+}
+
+void draw_list::add_sprite(shader_program& program, const texture2D& texture,
+                           const render_settings& settings,
+                           const frame_descriptor& frame)
+{
+  entries.push_back({make_key(settings.layer, settings.blend, settings.depth,
+                              program_id(program), texture_id(texture),
+                              next_sequence()),
+                     static_cast<std::uint32_t>(sprites.size()),
+                     item_type::sprite});
+  sprites.push_back({&program, &texture, settings, frame});
+}
+
+void draw_list::add_instances(shader_program& program,
+                              const texture2D& texture,
+                              const uniform<int>& texture_uniform, int layer,
+                              blend_mode blend,
+                              const sprite_quad::instance* data,
+                              std::uint32_t count)
+{
+  entries.push_back({make_key(layer, blend, 0.f, program_id(program),
+                              texture_id(texture), next_sequence()),
+                     static_cast<std::uint32_t>(instances.size()),
+                     item_type::instances});
+  instances.push_back({&program, &texture, texture_uniform,
+                       static_cast<std::uint32_t>(instance_data.size()),
+                       count});
+  instance_data.insert(instance_data.end(), data, data + count);
+}
+
+void draw_list::add_command(int layer, blend_mode blend,
+                            std::function<void()> command)
+{
+  entries.push_back({make_key(layer, blend, 0.f, 0, 0, next_sequence()),
+                     static_cast<std::uint32_t>(commands.size()),
+                     item_type::command});
+  commands.push_back(std::move(command));
+}
+
+void draw_list::append(draw_list& other)
+{
+  constexpr std::uint64_t sequence_mask{(std::uint64_t{1} << sequence_bits) -
+                                        1};
+  const std::uint32_t first_sprite{static_cast<std::uint32_t>(sprites.size())};
+  const std::uint32_t first_instances{
+      static_cast<std::uint32_t>(instances.size())};
+  const std::uint32_t first_instance{
+      static_cast<std::uint32_t>(instance_data.size())};
+  const std::uint32_t first_command{
+      static_cast<std::uint32_t>(commands.size())};
+
+  entries.reserve(entries.size() + other.entries.size());
+  for (const entry& item : other.entries)
+    {
+      std::uint32_t index{item.index};
+      switch (item.type)
+        {
+          case item_type::sprite:
+            index += first_sprite;
+            break;
+          case item_type::instances:
+            index += first_instances;
+            break;
+          case item_type::command:
+            index += first_command;
+            break;
+        }
+      entries.push_back(
+          {(item.key & ~sequence_mask) | (next_sequence() & sequence_mask),
+           index, item.type});
+    }
+
+  sprites.insert(sprites.end(), other.sprites.begin(), other.sprites.end());
+  for (const instances_item& item : other.instances)
+    instances.push_back({item.program, item.texture, item.texture_uniform,
+                         item.first + first_instance, item.count});
+  instance_data.insert(instance_data.end(), other.instance_data.begin(),
+                       other.instance_data.end());
+  for (std::function<void()>& command : other.commands)
+    commands.push_back(std::move(command));
+
+  other.clear();
+}
+
+void draw_list::sort_entries(std::vector<entry>& items, sort_buffers& buffers)
+{
+  const size_t count{items.size()};
+  if (count < 2) return;
+
+  constexpr std::uint64_t sequence_mask{(std::uint64_t{1} << sequence_bits) -
+                                        1};
+  constexpr unsigned int digit_bits{11};
+
+  // positions past the sequence bits can't be packed into the keys
+  if (count > sequence_mask + 1)
+    {
+      std::stable_sort(items.begin(), items.end(),
+                       [](const entry& a, const entry& b) {
+                         return a.key >> sequence_bits < b.key >> sequence_bits;
+                       });
+      return;
+    }
+
+  const std::uint64_t first_key{items[0].key};
+  std::uint64_t varying{0};
+  for (const entry& item : items) varying |= item.key ^ first_key;
+  varying &= ~sequence_mask;
+  // every key is equal, the entries are already in submission order
+  if (varying == 0) return;
+
+  // only the bits that differ between keys are sorted: they are packed
+  // together, so a frame of a few layers, programs and textures needs one
+  // or two passes instead of one per digit of the whole key
+  struct bit_run
+  {
+    unsigned int shift;
+    std::uint64_t mask;
+    unsigned int target;
+  };
+  std::array<bit_run, 32> runs{};
+  size_t run_count{0};
+  unsigned int width{0};
+  for (unsigned int bit{sequence_bits}; bit < 64;)
+    {
+      if (!(varying >> bit & 1))
+        {
+          bit++;
+          continue;
+        }
+      unsigned int length{0};
+      while (bit + length < 64 && varying >> (bit + length) & 1) length++;
+      runs[run_count++] = {bit, (std::uint64_t{1} << length) - 1, width};
+      width += length;
+      bit += length;
+    }
+
+  const unsigned int digits{(width + digit_bits - 1) / digit_bits};
+  const unsigned int pass_bits{(width + digits - 1) / digits};
+  const std::uint32_t radix{1u << pass_bits};
+
+  // packed keys keep the entry position in the sequence bits
+  buffers.keys.resize(count);
+  buffers.swap_keys.resize(count);
+  buffers.histograms.assign(digits * radix, 0);
+  for (size_t it{0}; it < count; it++)
+    {
+      const std::uint64_t key{items[it].key};
+      std::uint64_t packed{0};
+      for (size_t run{0}; run < run_count; run++)
+        packed |= (key >> runs[run].shift & runs[run].mask) << runs[run].target;
+      buffers.keys[it] = packed << sequence_bits | it;
+      for (unsigned int digit{0}; digit < digits; digit++)
+        buffers.histograms[digit * radix +
+                           (packed >> (digit * pass_bits) & (radix - 1))]++;
+    }
+
+  // LSD radix sort, the last pass moves the entries themselves
+  buffers.entries.resize(count);
+  std::uint64_t* source{buffers.keys.data()};
+  std::uint64_t* target{buffers.swap_keys.data()};
+  entry* sorted{buffers.entries.data()};
+  for (unsigned int digit{0}; digit < digits; digit++)
+    {
+      const unsigned int shift{sequence_bits + digit * pass_bits};
+      std::uint32_t* offsets{&buffers.histograms[digit * radix]};
+
+      std::uint32_t sum{0};
+      for (std::uint32_t bucket{0}; bucket < radix; bucket++)
+        {
+          const std::uint32_t digit_count{offsets[bucket]};
+          offsets[bucket] = sum;
+          sum += digit_count;
+        }
+      if (digit + 1 == digits)
+        {
+          for (size_t it{0}; it < count; it++)
+            sorted[offsets[source[it] >> shift & (radix - 1)]++] =
+                items[source[it] & sequence_mask];
+          break;
+        }
+      for (size_t it{0}; it < count; it++)
+        target[offsets[source[it] >> shift & (radix - 1)]++] = source[it];
+
+      std::swap(source, target);
+    }
+  items.swap(buffers.entries);
+}
+
+void draw_list::clear()
+{
+  entries.clear();
+  sprites.clear();
+  instances.clear();
+  instance_data.clear();
+  commands.clear();
+  sequence = 0;
+}
+}  // namespace render
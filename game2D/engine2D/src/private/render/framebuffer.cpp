@@ -0,0 +1,82 @@
+#include "render/framebuffer.h"
+#include <iostream>
+#include <utility>
+#include "render/renderer.h"
+
+namespace render
+{
+framebuffer::framebuffer(int width_, int height_, bool depth)
+    : width{width_}, height{height_}
+{
+  // a target may be created in the middle of a pass drawn into another one
+  const GLuint previous{renderer::get_bound_framebuffer()};
+  glGenTextures(1, &color);
+  renderer::bind_texture(color);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+               GL_UNSIGNED_BYTE, nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+  glGenFramebuffers(1, &id);
+  renderer::bind_framebuffer(id);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         color, 0);
+
+  if (depth)
+    {
+      glGenRenderbuffers(1, &depth_buffer);
+      glBindRenderbuffer(GL_RENDERBUFFER, depth_buffer);
+      glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width,
+                            height);
+      glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                                GL_RENDERBUFFER, depth_buffer);
+    }
+
+  const GLenum status{glCheckFramebufferStatus(GL_FRAMEBUFFER)};
+  complete = status == GL_FRAMEBUFFER_COMPLETE;
+  if (!complete)
+    std::cerr << "framebuffer: " << width << "x" << height
+              << " framebuffer is incomplete, status 0x" << std::hex << status
+              << std::dec << std::endl;
+
+  renderer::bind_framebuffer(previous);
+}
+
+void framebuffer::bind() const { renderer::bind_framebuffer(id); }
+
+void framebuffer::release()
+{
+  renderer::forget_framebuffer(id);
+  renderer::forget_texture(color);
+  glDeleteFramebuffers(1, &id);
+  glDeleteTextures(1, &color);
+  glDeleteRenderbuffers(1, &depth_buffer);
+}
+
+framebuffer::~framebuffer() { release(); }
+
+framebuffer::framebuffer(framebuffer&& buffer)
+    : id{std::exchange(buffer.id, 0)},
+      color{std::exchange(buffer.color, 0)},
+      depth_buffer{std::exchange(buffer.depth_buffer, 0)},
+      width{buffer.width},
+      height{buffer.height},
+      complete{std::exchange(buffer.complete, false)}
+{
+}
+
+framebuffer& framebuffer::operator=(framebuffer&& buffer)
+{
+  release();
+
+  id = std::exchange(buffer.id, 0);
+  color = std::exchange(buffer.color, 0);
+  depth_buffer = std::exchange(buffer.depth_buffer, 0);
+  width = buffer.width;
+  height = buffer.height;
+  complete = std::exchange(buffer.complete, false);
+  return *this;
+}
+}  // namespace render
@@ -1,26 +1,38 @@
 #include "render/index_buffer.h"
+#include "render/renderer.h"
 
 namespace render
 {
-index_buffer::index_buffer()
+index_buffer::index_buffer(buffer_usage usage_) : usage{usage_}
 {
   glGenBuffers(1, &id);
   restore(0, nullptr);
 }
-index_buffer::index_buffer(const unsigned int count_, const unsigned int* data)
+index_buffer::index_buffer(const unsigned int count_, const unsigned int* data,
+                           buffer_usage usage_)
+    : usage{usage_}
 {
   glGenBuffers(1, &id);
   restore(count_, data);
 }
 
-void index_buffer::bind() const { glBindBuffer(buffer_type, id); }
-void index_buffer::detach() const { glBindBuffer(buffer_type, 0); }
+void index_buffer::bind() const { renderer::bind_buffer(buffer_type, id); }
+void index_buffer::detach() const { renderer::bind_buffer(buffer_type, 0); }
 
 void index_buffer::update(const unsigned int count_, const unsigned int* data)
 {
-  glBindBuffer(buffer_type, id);
+  // element buffer binding is a part of vao state
+  renderer::bind_vertex_array(0);
+  bind();
+  // orphan the old storage, so the driver doesn't wait for draws using it
+  if (count_ > capacity || usage != buffer_usage::static_draw)
+    {
+      if (count_ > capacity) capacity = count_;
+      glBufferData(buffer_type, capacity * element_size, nullptr,
+                   to_gl_usage(usage));
+    }
   glBufferSubData(buffer_type, 0, count_ * element_size, data);
-  if (count_ < count) count = count_;
+  count = count_;
 }
 
 index_buffer::index_buffer(index_buffer&& buffer)
@@ -31,6 +43,7 @@ index_buffer::index_buffer(index_buffer&& buffer)
 
 index_buffer& index_buffer::operator=(index_buffer&& buffer)
 {
+  renderer::forget_buffer(id);
   glDeleteBuffers(1, &id);
 
   id = buffer.id;
@@ -39,15 +52,25 @@ index_buffer& index_buffer::operator=(index_buffer&& buffer)
   count = buffer.count;
   buffer.count = 0;
 
+  capacity = buffer.capacity;
+  buffer.capacity = 0;
+  usage = buffer.usage;
+
   return *this;
 }
 
 void index_buffer::restore(const unsigned int count_, const unsigned int* data)
 {
   count = count_;
-  glBindBuffer(buffer_type, id);
-  glBufferData(buffer_type, count * element_size, data, GL_STATIC_DRAW);
+  capacity = count_;
+  renderer::bind_vertex_array(0);
+  bind();
+  glBufferData(buffer_type, count * element_size, data, to_gl_usage(usage));
 }
 
-index_buffer::~index_buffer() { glDeleteBuffers(1, &id); }
+index_buffer::~index_buffer()
+{
+  renderer::forget_buffer(id);
+  glDeleteBuffers(1, &id);
+}
 }  // namespace render
@@ -0,0 +1,169 @@
+#include "render/post_processor.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include "render/renderer.h"
+#include "render/texture2D.h"
+#include "render/vertex_buffer_descriptor.h"
+
+namespace render
+{
+post_processor::post_processor()
+{
+  vao.bind();
+
+  float quad_pos[]{0, 0, 0, 1, 1, 0, 1, 1};
+  vbo.restore(sizeof(quad_pos), quad_pos);
+
+  vertex_buffer_descriptor descriptor{};
+  descriptor.add_element_descriptor_float(2, false);
+  vao.bind_vertex_buffer(vbo, descriptor);
+
+  unsigned int indices[]{1, 0, 2, 3};
+  vebo.restore(4, indices);
+}
+
+bool post_processor::begin(const glm::ivec4& viewport, float scale)
+{
+  const int width{
+      std::max(1, static_cast<int>(static_cast<float>(viewport.z) * scale))};
+  const int height{
+      std::max(1, static_cast<int>(static_cast<float>(viewport.w) * scale))};
+  scene = renderer::acquire_target(width, height);
+  if (!scene) return false;
+
+  scene->bind();
+  glViewport(0, 0, width, height);
+  return true;
+}
+
+glm::ivec4 post_processor::get_scene_viewport() const
+{
+  if (!scene) return glm::ivec4{0};
+  return {0, 0, scene->get_width(), scene->get_height()};
+}
+
+post_processor::pass_uniforms& post_processor::get_uniforms(
+    const post_process_pass& pass)
+{
+  auto found = uniforms.find(pass.program.get());
+  if (found == uniforms.end())
+    {
+      pass_uniforms resolved{};
+      resolved.texture = pass.program->get_uniform<int>("s_texture");
+      resolved.texel = pass.program->get_uniform<glm::vec2>("s_texel");
+      resolved.parameters =
+          pass.program->get_uniform<glm::vec4>("s_parameters");
+      found = uniforms.emplace(pass.program.get(), resolved).first;
+    }
+  // only passes reading the frame declare s_scene
+  if (pass.scene_input && !found->second.scene_resolved)
+    {
+      found->second.scene_resolved = true;
+      found->second.scene = pass.program->get_uniform<int>("s_scene");
+    }
+  return found->second;
+}
+
+void post_processor::blit(const framebuffer& source, GLuint output,
+                          const glm::ivec4& viewport)
+{
+  renderer::bind_framebuffer(output);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, source.get_id());
+  glBlitFramebuffer(0, 0, source.get_width(), source.get_height(), viewport.x,
+                    viewport.y, viewport.x + viewport.z,
+                    viewport.y + viewport.w, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, output);
+}
+
+void post_processor::finish(const std::vector<post_process_pass>& passes,
+                            GLuint output, const glm::ivec4& viewport,
+                            bool profile, frame_stats& stats)
+{
+  if (!scene) return;
+
+  if (passes.empty())
+    {
+      // the reduced resolution frame is upscaled without a shader pass
+      blit(*scene, output, viewport);
+      renderer::release_target(std::move(scene));
+      glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+      return;
+    }
+
+  renderer::set_blend(false);
+  renderer::set_depth_test(false);
+
+  std::unique_ptr<framebuffer> input{};
+  const framebuffer* source{scene.get()};
+  for (size_t index{0}; index < passes.size(); index++)
+    {
+      const post_process_pass& pass{passes[index]};
+      const auto start = std::chrono::steady_clock::now();
+
+      // the last pass writes the window, the others - a pooled target
+      const bool last{index + 1 == passes.size()};
+      std::unique_ptr<framebuffer> target{};
+      if (last)
+        {
+          renderer::bind_framebuffer(output);
+          glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+        }
+      else
+        {
+          const int width{std::max(
+              1, static_cast<int>(static_cast<float>(viewport.z) * pass.scale))};
+          const int height{std::max(
+              1, static_cast<int>(static_cast<float>(viewport.w) * pass.scale))};
+          target = renderer::acquire_target(width, height, false);
+          if (!target)
+            {
+              // show the last finished pass instead of a stale window
+              blit(*source, output, viewport);
+              break;
+            }
+          target->bind();
+          glViewport(0, 0, width, height);
+        }
+
+      if (pass.program)
+        {
+          pass_uniforms& current{get_uniforms(pass)};
+          shader_program& program{*pass.program};
+          program.use();
+          program.set(current.texture, 0);
+          program.set(current.texel,
+                      glm::vec2{1.f / static_cast<float>(source->get_width()),
+                                1.f / static_cast<float>(source->get_height())});
+          program.set(current.parameters, pass.parameters);
+          if (pass.scene_input)
+            {
+              program.set(current.scene, 1);
+              texture2D::active_texture(1);
+              renderer::bind_texture(scene->get_color_texture());
+            }
+          texture2D::active_texture(0);
+          renderer::bind_texture(source->get_color_texture());
+
+          renderer::draw(vao, vebo, program, GL_TRIANGLE_FAN);
+        }
+      if (profile) glFinish();
+
+      if (index < frame_stats::max_timed_passes)
+        stats.post_pass_ms[index] = std::chrono::duration<float, std::milli>(
+                                        std::chrono::steady_clock::now() - start)
+                                        .count();
+      stats.post_passes++;
+
+      renderer::release_target(std::move(input));
+      input = std::move(target);
+      source = input.get();
+    }
+
+  renderer::release_target(std::move(input));
+  renderer::release_target(std::move(scene));
+  renderer::bind_framebuffer(output);
+  glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+  renderer::set_depth_test(true);
+}
+}  // namespace render
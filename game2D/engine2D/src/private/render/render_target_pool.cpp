@@ -0,0 +1,50 @@
+#include "render/render_target_pool.h"
+#include <iostream>
+
+namespace render
+{
+std::unique_ptr<framebuffer> render_target_pool::acquire(int width,
+                                                         int height,
+                                                         bool depth)
+{
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    for (auto it{free_targets.begin()}; it != free_targets.end(); it++)
+      if ((*it)->get_width() == width && (*it)->get_height() == height &&
+          (*it)->has_depth() == depth)
+        {
+          std::unique_ptr<framebuffer> target{std::move(*it)};
+          free_targets.erase(it);
+          return target;
+        }
+  }
+
+  auto target = std::make_unique<framebuffer>(width, height, depth);
+  if (!target->is_complete())
+    {
+      std::cerr << "render_target_pool:: can't create " << width << "x"
+                << height << " render target" << std::endl;
+      return nullptr;
+    }
+  return target;
+}
+
+void render_target_pool::release(std::unique_ptr<framebuffer> target)
+{
+  if (!target) return;
+  std::lock_guard<std::mutex> lock{mutex};
+  free_targets.push_back(std::move(target));
+}
+
+void render_target_pool::clear()
+{
+  std::lock_guard<std::mutex> lock{mutex};
+  free_targets.clear();
+}
+
+size_t render_target_pool::get_free_count() const
+{
+  std::lock_guard<std::mutex> lock{mutex};
+  return free_targets.size();
+}
+}  // namespace render
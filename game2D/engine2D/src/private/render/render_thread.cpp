@@ -0,0 +1,69 @@
+#include "render/render_thread.h"
+#include <utility>
+
+namespace render
+{
+render_thread::render_thread(std::function<void()> attach_,
+                             std::function<void(frame_packet&)> execute_,
+                             std::function<void()> detach_)
+    : attach{std::move(attach_)},
+      execute{std::move(execute_)},
+      detach{std::move(detach_)}
+{
+  thread = std::thread{&render_thread::run, this};
+}
+
+void render_thread::submit(frame_packet& packet)
+{
+  std::unique_lock<std::mutex> lock{mutex};
+  condition.wait(lock, [this]() { return !has_pending && !busy; });
+  std::swap(pending, packet);
+  has_pending = true;
+  condition.notify_all();
+}
+
+frame_stats render_thread::get_stats()
+{
+  std::lock_guard<std::mutex> lock{mutex};
+  return last_stats;
+}
+
+void render_thread::stop()
+{
+  if (!thread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    stopping = true;
+  }
+  condition.notify_all();
+  thread.join();
+}
+
+render_thread::~render_thread() { stop(); }
+
+void render_thread::run()
+{
+  attach();
+  std::unique_lock<std::mutex> lock{mutex};
+  while (true)
+    {
+      condition.wait(lock, [this]() { return has_pending || stopping; });
+      // the last submitted frame is drawn before stopping
+      if (!has_pending) break;
+
+      has_pending = false;
+      busy = true;
+      lock.unlock();
+
+      // the game thread doesn't touch the pending packet while busy is set
+      execute(pending);
+
+      lock.lock();
+      busy = false;
+      last_stats = pending.stats;
+      condition.notify_all();
+    }
+  lock.unlock();
+  detach();
+}
+}  // namespace render
@@ -1,10 +1,38 @@
 #include "render/renderer.h"
 #include "core/engine.h"
+#include "render/command_list_impl.h"
+#include "render/framebuffer.h"
 #include "render/index_buffer.h"
+#include "render/post_processor.h"
+#include "render/render_target_pool.h"
+#include "render/render_thread.h"
+#include "render/resolution_controller.h"
 #include "render/shader_program.h"
+#include "render/sprite_batch.h"
+#include "render/sprite_quad.h"
+#include "render/uniform_buffer.h"
 #include "render/vertex_array.h"
+#include <glm/common.hpp>
+#include <algorithm>
+#include <iostream>
+#include <utility>
 namespace render
 {
+std::unique_ptr<sprite_batch> renderer::batch{nullptr};
+std::unique_ptr<sprite_quad> renderer::quad{nullptr};
+std::unique_ptr<uniform_buffer> renderer::frame_buffer{nullptr};
+renderer::state_cache renderer::state{};
+frame_uniforms renderer::frame_data{};
+std::unique_ptr<render_thread> renderer::thread{nullptr};
+std::function<void()> renderer::present{};
+frame_packet renderer::recording{};
+std::unique_ptr<framebuffer> renderer::offscreen{nullptr};
+std::unique_ptr<sprite_batch> renderer::target_batch{nullptr};
+std::unique_ptr<render_target_pool> renderer::targets{nullptr};
+std::unique_ptr<post_processor> renderer::post{nullptr};
+std::unique_ptr<resolution_controller> renderer::resolution{nullptr};
+renderer::frame_capture renderer::captured{};
+
 void renderer::draw(const vertex_array& vao, const index_buffer& vebo,
                     const shader_program& program, GLenum mode)
 {
@@ -14,16 +42,544 @@ void renderer::draw(const vertex_array& vao, const index_buffer& vebo,
 
   glDrawElements(mode, static_cast<int>(vebo.get_count()), GL_UNSIGNED_INT,
                  nullptr);
+  stats.draw_calls++;
+}
+void renderer::draw(const vertex_array& vao, const index_buffer& vebo,
+                    const shader_program& program, unsigned int count,
+                    unsigned int first, GLenum mode)
+{
+  program.use();
+  vao.bind();
+  vebo.bind();
+
+  glDrawElements(mode, static_cast<int>(count), GL_UNSIGNED_INT,
+                 reinterpret_cast<const void*>(first * sizeof(GLuint)));
+  stats.draw_calls++;
+}
+void renderer::draw_instanced(const vertex_array& vao,
+                              const index_buffer& vebo,
+                              const shader_program& program,
+                              unsigned int instance_count, GLenum mode)
+{
+  program.use();
+  vao.bind();
+  vebo.bind();
+
+  glDrawElementsInstanced(mode, static_cast<int>(vebo.get_count()),
+                          GL_UNSIGNED_INT, nullptr,
+                          static_cast<int>(instance_count));
+  stats.draw_calls++;
+}
+
+void renderer::init(bool batching_)
+{
+  state = state_cache{};
+  camera = camera2D{};
+  stats = frame_stats{};
+  last_stats = frame_stats{};
+  batching = batching_;
+  batch = std::make_unique<sprite_batch>();
+  quad = std::make_unique<sprite_quad>();
+  target_batch = std::make_unique<sprite_batch>();
+  targets = std::make_unique<render_target_pool>();
+  post = std::make_unique<post_processor>();
+  frame_data = frame_uniforms{};
+  frame_buffer = std::make_unique<uniform_buffer>(
+      frame_block_binding, static_cast<unsigned int>(sizeof(frame_uniforms)));
+  frame_buffer->update(sizeof(frame_uniforms), &frame_data);
+}
+void renderer::dispose()
+{
+  stop_thread();
+  submitted_lists.clear();
+  recording = frame_packet{};
+  batch.reset();
+  quad.reset();
+  target_batch.reset();
+  post.reset();
+  post_passes.clear();
+  resolution.reset();
+  resolution_scale = 1.f;
+  targets.reset();
+  frame_buffer.reset();
+  offscreen.reset();
+  default_framebuffer = 0;
+  capture_requested = false;
+}
+
+void renderer::update_frame_data(float time, float delta)
+{
+  if (resolution && resolution->update(delta * 1000.f))
+    resolution_scale = resolution->get_scale();
+  frame_data.time = {time, delta, 0.f, 0.f};
+  glm::vec2 size{static_cast<float>(viewport.z),
+                 static_cast<float>(viewport.w)};
+  // with dynamic resolution the scene is drawn into the scaled target,
+  // sized the same way as in post_processor::begin
+  if (post && resolution_scale < 1.f)
+    size = glm::max(glm::vec2{1.f}, glm::floor(size * resolution_scale));
+  frame_data.viewport = {size, glm::vec2{1.f} / glm::max(size, glm::vec2{1})};
+  // the render thread uploads the snapshot taken at the end of the frame
+  if (!thread) upload_frame_data();
+}
+void renderer::sync_frame_data()
+{
+  if (camera.get_view_projection() != frame_data.view_projection)
+    upload_frame_data();
+}
+void renderer::upload_frame_data()
+{
+  frame_data.view_projection = camera.get_view_projection();
+  applied_frame = frame_data;
+  if (frame_buffer)
+    frame_buffer->update(sizeof(frame_uniforms), &frame_data);
+}
+
+void renderer::submit(shader_program& program, const texture2D& texture,
+                      const render_settings& settings,
+                      const frame_descriptor& frame)
+{
+  if (!camera.is_visible(settings))
+    {
+      stats.culled_sprites++;
+      return;
+    }
+  stats.drawn_sprites++;
+
+  batch->push(program, texture, settings, frame);
+  if (!batching) flush();
+}
+void renderer::submit_instances(shader_program& program,
+                                const texture2D& texture,
+                                const uniform<int>& texture_uniform,
+                                int layer, blend_mode blend,
+                                const sprite_quad::instance* data,
+                                unsigned int count)
+{
+  visible_instances.clear();
+  for (unsigned int it{0}; it < count; it++)
+    {
+      const glm::vec4& position_size{data[it].position_size};
+      if (camera.is_visible({position_size.x, position_size.y},
+                            {position_size.z, position_size.w}))
+        visible_instances.push_back(data[it]);
+    }
+  const unsigned int visible{
+      static_cast<unsigned int>(visible_instances.size())};
+  stats.culled_sprites += count - visible;
+  stats.drawn_sprites += visible;
+  if (visible == 0) return;
+
+  batch->push_instances(program, texture, texture_uniform, layer, blend,
+                        visible_instances.data(), visible);
+  if (!batching) flush();
+}
+void renderer::submit_command(int layer, blend_mode blend,
+                              std::function<void()> command)
+{
+  batch->push_command(layer, blend, std::move(command));
+  if (!batching) flush();
+}
+void renderer::submit_list(command_list& list)
+{
+  stats.drawn_sprites += list.impl->drawn_sprites;
+  stats.culled_sprites += list.impl->culled_sprites;
+  submitted_lists.push_back(&list);
+  if (!batching) flush();
+}
+void renderer::merge_lists()
+{
+  if (submitted_lists.empty()) return;
+
+  // list ids define the order, so thread timing doesn't affect the frame
+  std::stable_sort(submitted_lists.begin(), submitted_lists.end(),
+                   [](const command_list* a, const command_list* b) {
+                     return a->get_id() < b->get_id();
+                   });
+  for (command_list* list : submitted_lists) batch->append(list->impl->list);
+  submitted_lists.clear();
+}
+void renderer::flush()
+{
+  if (!batch || thread) return;
+  merge_lists();
+  sync_frame_data();
+  batch->flush();
+}
+void renderer::end_frame()
+{
+  if (!thread)
+    {
+      flush();
+      if (post && post->is_active())
+        {
+          post->finish(post_passes, default_framebuffer, viewport,
+                       post_profile, stats);
+          applied_viewport = viewport;
+        }
+      if (capture_requested) capture(viewport);
+      capture_requested = false;
+      if (batch) batch->end_frame();
+      if (target_batch) target_batch->end_frame();
+      if (quad) quad->end_frame();
+      return;
+    }
+
+  recording.frame = frame_data;
+  recording.frame.view_projection = camera.get_view_projection();
+  recording.viewport = viewport;
+  recording.clear_color = clear_rgba;
+  recording.stats = stats;
+  recording.capture = std::exchange(capture_requested, false);
+  recording.post_process = post_passes;
+  recording.post_profile = post_profile;
+  recording.resolution_scale = resolution_scale;
+  merge_lists();
+  batch->swap_list(recording.list);
+  // returns the packet of the previous frame, already drawn and cleared
+  thread->submit(recording);
+}
+
+void renderer::start_thread(std::function<void()> attach,
+                            std::function<void()> present_,
+                            std::function<void()> detach)
+{
+  if (thread) return;
+  present = std::move(present_);
+  thread = std::make_unique<render_thread>(std::move(attach), execute,
+                                           std::move(detach));
+}
+void renderer::stop_thread()
+{
+  if (!thread) return;
+  thread->stop();
+  thread.reset();
+  present = nullptr;
+}
+void renderer::execute(frame_packet& packet)
+{
+  // counters of the render thread
+  stats = frame_stats{};
+
+  glViewport(packet.viewport.x, packet.viewport.y, packet.viewport.z,
+             packet.viewport.w);
+  applied_viewport = packet.viewport;
+  if ((!packet.post_process.empty() || packet.resolution_scale < 1.f) &&
+      post->begin(packet.viewport, packet.resolution_scale))
+    applied_viewport = post->get_scene_viewport();
+  glClearColor(packet.clear_color.r, packet.clear_color.g,
+               packet.clear_color.b, packet.clear_color.a);
+  clear();
+
+  applied_frame = packet.frame;
+  frame_buffer->update(sizeof(frame_uniforms), &packet.frame);
+  batch->execute(packet.list);
+  if (post->is_active())
+    {
+      post->finish(packet.post_process, default_framebuffer, packet.viewport,
+                   packet.post_profile, stats);
+      applied_viewport = packet.viewport;
+    }
+  if (packet.capture) capture(packet.viewport);
+  batch->end_frame();
+  target_batch->end_frame();
+  quad->end_frame();
+  present();
+
+  packet.stats.draw_calls += stats.draw_calls;
+  packet.stats.state_calls += stats.state_calls;
+  packet.stats.skipped_state_calls += stats.skipped_state_calls;
+  packet.stats.buffer_waits += stats.buffer_waits;
+  packet.stats.post_passes = stats.post_passes;
+  packet.stats.post_pass_ms = stats.post_pass_ms;
+}
+bool renderer::create_offscreen_target(int width, int height)
+{
+  auto target = std::make_unique<framebuffer>(width, height);
+  if (!target->is_complete())
+    {
+      std::cerr << "renderer:: offscreen target error: can't create "
+                << width << "x" << height << " framebuffer" << std::endl;
+      return false;
+    }
+  offscreen = std::move(target);
+  default_framebuffer = offscreen->get_id();
+  bind_framebuffer(default_framebuffer);
+  return true;
+}
+void renderer::request_capture() { capture_requested = true; }
+void renderer::capture(const glm::ivec4& area)
+{
+  const int width{area.z}, height{area.w};
+  if (width <= 0 || height <= 0) return;
+
+  const size_t row{static_cast<size_t>(width) * 4};
+  std::vector<unsigned char> pixels(row * static_cast<size_t>(height));
+  bind_framebuffer(default_framebuffer);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(area.x, area.y, width, height, GL_RGBA, GL_UNSIGNED_BYTE,
+               pixels.data());
+
+  // gl rows go bottom-up, images are stored top-down
+  for (int top{0}, bottom{height - 1}; top < bottom; top++, bottom--)
+    std::swap_ranges(pixels.begin() + static_cast<long>(row * top),
+                     pixels.begin() + static_cast<long>(row * (top + 1)),
+                     pixels.begin() + static_cast<long>(row * bottom));
+
+  std::lock_guard<std::mutex> lock{captured.mutex};
+  captured.pixels = std::move(pixels);
+  captured.width = width;
+  captured.height = height;
+  captured.ready = true;
+}
+bool renderer::take_capture(std::vector<unsigned char>& rgba, int& width,
+                            int& height)
+{
+  std::lock_guard<std::mutex> lock{captured.mutex};
+  if (!captured.ready) return false;
+  rgba = std::move(captured.pixels);
+  width = captured.width;
+  height = captured.height;
+  captured.ready = false;
+  return true;
 }
+
+std::unique_ptr<framebuffer> renderer::acquire_target(int width, int height,
+                                                     bool depth)
+{
+  if (!targets) return nullptr;
+  return targets->acquire(width, height, depth);
+}
+void renderer::release_target(std::unique_ptr<framebuffer> target)
+{
+  if (targets) targets->release(std::move(target));
+}
+void renderer::draw_to_target(framebuffer& target,
+                              const glm::mat4x4& view_projection,
+                              draw_list& items)
+{
+  const GLuint previous{state.framebuffer};
+  target.bind();
+  glViewport(0, 0, target.get_width(), target.get_height());
+
+  // glClearBuffer leaves the clear color of the frame untouched
+  const GLfloat transparent[]{0.f, 0.f, 0.f, 0.f};
+  const GLfloat far_depth{1.f};
+  set_depth_write(true);
+  glClearBufferfv(GL_COLOR, 0, transparent);
+  glClearBufferfv(GL_DEPTH, 0, &far_depth);
+
+  frame_uniforms pass{applied_frame};
+  const glm::vec2 size{static_cast<float>(target.get_width()),
+                       static_cast<float>(target.get_height())};
+  pass.view_projection = view_projection;
+  pass.viewport = {size, glm::vec2{1.f} / glm::max(size, glm::vec2{1})};
+  frame_buffer->update(sizeof(frame_uniforms), &pass);
+
+  target_batch->execute(items);
+
+  frame_buffer->update(sizeof(frame_uniforms), &applied_frame);
+  bind_framebuffer(previous);
+  glViewport(applied_viewport.x, applied_viewport.y, applied_viewport.z,
+             applied_viewport.w);
+}
+
+bool renderer::changed(bool differs)
+{
+  if (differs)
+    stats.state_calls++;
+  else
+    stats.skipped_state_calls++;
+  return differs;
+}
+
+void renderer::use_program(GLuint id)
+{
+  if (!changed(state.program != id)) return;
+  state.program = id;
+  glUseProgram(id);
+}
+void renderer::bind_vertex_array(GLuint id)
+{
+  if (!changed(state.vertex_array != id)) return;
+  state.vertex_array = id;
+  state.element_buffer = state_cache::unknown;
+  glBindVertexArray(id);
+}
+void renderer::bind_buffer(GLenum target, GLuint id)
+{
+  GLuint* bound{nullptr};
+  switch (target)
+    {
+      case GL_ARRAY_BUFFER:
+        bound = &state.array_buffer;
+        break;
+      case GL_ELEMENT_ARRAY_BUFFER:
+        bound = &state.element_buffer;
+        break;
+      case GL_UNIFORM_BUFFER:
+        bound = &state.uniform_buffer;
+        break;
+      default:
+        // untracked target
+        changed(true);
+        glBindBuffer(target, id);
+        return;
+    }
+  if (!changed(*bound != id)) return;
+  *bound = id;
+  glBindBuffer(target, id);
+}
+void renderer::bind_buffer_base(GLenum target, unsigned int index, GLuint id)
+{
+  // indexed bindings are set once per buffer, so they are not cached
+  changed(true);
+  if (target == GL_UNIFORM_BUFFER) state.uniform_buffer = id;
+  glBindBufferBase(target, index, id);
+}
+void renderer::active_texture(unsigned int unit)
+{
+  if (!changed(state.texture_unit != unit)) return;
+  state.texture_unit = unit;
+  glActiveTexture(GL_TEXTURE0 + unit);
+}
+void renderer::bind_texture(GLuint id)
+{
+  GLuint& bound{state.textures[state.texture_unit]};
+  if (!changed(bound != id)) return;
+  bound = id;
+  glBindTexture(GL_TEXTURE_2D, id);
+}
+void renderer::set_depth_test(bool enabled)
+{
+  if (!changed(state.depth_test != enabled)) return;
+  state.depth_test = enabled;
+  if (enabled)
+    glEnable(GL_DEPTH_TEST);
+  else
+    glDisable(GL_DEPTH_TEST);
+}
+void renderer::set_depth_write(bool enabled)
+{
+  if (!changed(state.depth_write != enabled)) return;
+  state.depth_write = enabled;
+  glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+}
+void renderer::set_depth_func(GLenum func)
+{
+  if (!changed(state.depth_func != func)) return;
+  state.depth_func = func;
+  glDepthFunc(func);
+}
+void renderer::set_blend(bool enabled)
+{
+  if (!changed(state.blend != enabled)) return;
+  state.blend = enabled;
+  if (enabled)
+    glEnable(GL_BLEND);
+  else
+    glDisable(GL_BLEND);
+}
+void renderer::set_blend_func(GLenum src, GLenum dst)
+{
+  if (!changed(state.blend_src != src || state.blend_dst != dst)) return;
+  state.blend_src = src;
+  state.blend_dst = dst;
+  glBlendFunc(src, dst);
+}
+void renderer::set_blend_mode(blend_mode mode)
+{
+  // translucent items are hidden by opaque ones, but don't hide each other
+  const bool translucent{mode == blend_mode::translucent};
+  set_blend(translucent);
+  if (translucent) set_blend_func(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+  set_depth_write(!translucent);
+}
+void renderer::bind_framebuffer(GLuint id)
+{
+  if (!changed(state.framebuffer != id)) return;
+  state.framebuffer = id;
+  glBindFramebuffer(GL_FRAMEBUFFER, id);
+}
+
+void renderer::forget_program(GLuint id)
+{
+  if (state.program == id) state.program = state_cache::unknown;
+}
+void renderer::forget_vertex_array(GLuint id)
+{
+  // deleting the bound vao reverts the binding to the default one
+  if (state.vertex_array == id)
+    {
+      state.vertex_array = 0;
+      state.element_buffer = state_cache::unknown;
+    }
+}
+void renderer::forget_buffer(GLuint id)
+{
+  if (state.array_buffer == id) state.array_buffer = 0;
+  if (state.element_buffer == id) state.element_buffer = state_cache::unknown;
+  if (state.uniform_buffer == id) state.uniform_buffer = 0;
+}
+void renderer::forget_texture(GLuint id)
+{
+  for (GLuint& texture : state.textures)
+    if (texture == id) texture = 0;
+}
+void renderer::forget_framebuffer(GLuint id)
+{
+  // deleting the bound framebuffer reverts the binding to the window one
+  if (state.framebuffer == id) state.framebuffer = 0;
+}
+
+void renderer::begin_frame()
+{
+  last_stats = thread ? thread->get_stats() : stats;
+  stats = frame_stats{};
+  stats.resolution_scale = resolution_scale;
+
+  // the frame is drawn into the post-processing target from its first draw
+  if (!thread && post && (!post_passes.empty() || resolution_scale < 1.f) &&
+      post->begin(viewport, resolution_scale))
+    applied_viewport = post->get_scene_viewport();
+}
+void renderer::set_post_process(std::vector<post_process_pass> passes,
+                                bool profile)
+{
+  post_passes = std::move(passes);
+  post_profile = profile;
+}
+void renderer::set_dynamic_resolution(bool enabled, float budget_ms,
+                                      float min_scale)
+{
+  resolution_scale = 1.f;
+  if (!enabled)
+    {
+      resolution.reset();
+      return;
+    }
+  if (!resolution) resolution = std::make_unique<resolution_controller>();
+  resolution->configure(budget_ms, min_scale);
+}
+
 void renderer::set_viewport(int x, int y, int width, int height)
 {
+  viewport = {x, y, width, height};
+  // the render thread applies the viewport of every recorded frame
+  if (thread) return;
+  applied_viewport = viewport;
   glViewport(x, y, width, height);
 }
 void renderer::clear_color(float r, float g, float b, float a)
 {
-  glClearColor(r, g, b, a);
+  clear_rgba = {r, g, b, a};
+  if (!thread) glClearColor(r, g, b, a);
+}
+void renderer::clear()
+{
+  set_depth_write(true);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
-void renderer::clear() { glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); }
 
 // void renderer::swap_buffers() { SDL_GL_SwapWindow(engine::window::window); }
 }  // namespace render
@@ -0,0 +1,63 @@
+#include "render/resolution_controller.h"
+#include <algorithm>
+#include <numeric>
+
+namespace render
+{
+void resolution_controller::configure(float budget_ms, float min_scale_)
+{
+  budget = std::max(budget_ms, 1.f);
+  min_scale = std::clamp(min_scale_, scale_step, 1.f);
+  probe_delay = min_probe_delay;
+  probing = false;
+  stable_frames = 0;
+  change_scale(1.f);
+}
+
+bool resolution_controller::update(float frame_ms)
+{
+  history[frames % history_size] = frame_ms;
+  frames++;
+  if (frames < history_size) return false;
+
+  const float average{std::accumulate(history.begin(), history.end(), 0.f) /
+                      static_cast<float>(history_size)};
+
+  if (average > budget * over_budget)
+    {
+      stable_frames = 0;
+      if (scale <= min_scale) return false;
+      // the probe failed, so the next one waits longer
+      if (probing) probe_delay = std::min(probe_delay * 2, max_probe_delay);
+      probing = false;
+      change_scale(std::max(scale - scale_step, min_scale));
+      return true;
+    }
+
+  stable_frames++;
+  // the probed scale held, later spikes aren't blamed on it
+  if (probing && stable_frames > history_size) probing = false;
+  if (scale >= 1.f) return false;
+  if (average < budget * under_budget)
+    {
+      probe_delay = min_probe_delay;
+      probing = false;
+      change_scale(std::min(scale + scale_step, 1.f));
+      return true;
+    }
+  if (stable_frames >= probe_delay)
+    {
+      probing = true;
+      change_scale(std::min(scale + scale_step, 1.f));
+      return true;
+    }
+  return false;
+}
+
+void resolution_controller::change_scale(float new_scale)
+{
+  scale = new_scale;
+  frames = 0;
+  stable_frames = 0;
+}
+}  // namespace render
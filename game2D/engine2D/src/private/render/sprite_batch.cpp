@@ -0,0 +1,195 @@
+#include "render/sprite_batch.h"
+#include <glm/mat4x4.hpp>
+#include "render/renderer.h"
+#include "render/shader_program.h"
+#include "render/texture2D.h"
+namespace render
+{
+sprite_batch::sprite_batch()
+{
+  vao.bind();
+
+  descriptor.add_element_descriptor_float(2, false);
+  descriptor.add_element_descriptor_float(2, false);
+  vao.bind_vertex_buffer(vbo, descriptor);
+
+  reserve_indices(4096);
+}
+
+void sprite_batch::reserve_indices(size_t sprites)
+{
+  if (sprites <= index_capacity) return;
+
+  size_t capacity{index_capacity == 0 ? 1 : index_capacity};
+  while (capacity < sprites) capacity *= 2;
+
+  std::vector<unsigned int> indices(capacity * indices_per_sprite);
+  for (unsigned int sprite{0}; sprite < capacity; sprite++)
+    {
+      const unsigned int vertex{sprite * vertices_per_sprite};
+      unsigned int* quad{&indices[sprite * indices_per_sprite]};
+      quad[0] = vertex + 0;
+      quad[1] = vertex + 1;
+      quad[2] = vertex + 2;
+      quad[3] = vertex + 2;
+      quad[4] = vertex + 1;
+      quad[5] = vertex + 3;
+    }
+  ibo.restore(static_cast<unsigned int>(indices.size()), indices.data());
+  index_capacity = capacity;
+}
+
+void sprite_batch::push(shader_program& program, const texture2D& texture,
+                        const render_settings& settings,
+                        const frame_descriptor& frame)
+{
+  list.add_sprite(program, texture, settings, frame);
+}
+
+void sprite_batch::push_instances(shader_program& program,
+                                  const texture2D& texture,
+                                  const uniform<int>& texture_uniform,
+                                  int layer, blend_mode blend,
+                                  const sprite_quad::instance* data,
+                                  unsigned int count)
+{
+  list.add_instances(program, texture, texture_uniform, layer, blend, data,
+                     count);
+}
+
+void sprite_batch::push_command(int layer, blend_mode blend,
+                                std::function<void()> command)
+{
+  list.add_command(layer, blend, std::move(command));
+}
+
+void sprite_batch::flush() { execute(list); }
+
+void sprite_batch::execute(draw_list& items)
+{
+  if (items.empty()) return;
+
+  items.sort();
+
+  // build vertices and runs in the sorted order
+  const std::vector<draw_list::sprite_item>& sprites{items.get_sprites()};
+  vertices.resize(sprites.size() * vertices_per_sprite);
+  vertex* out{vertices.data()};
+  unsigned int sprite_count{0};
+  for (const draw_list::entry& item : items.get_entries())
+    {
+      const blend_mode blend{draw_list::get_blend(item)};
+      if (item.type != draw_list::item_type::sprite)
+        {
+          runs.push_back(
+              {item.type, nullptr, nullptr, 0, blend, item.index, 0});
+          continue;
+        }
+
+      const draw_list::sprite_item& sprite{sprites[item.index]};
+      if (runs.empty() || runs.back().type != draw_list::item_type::sprite ||
+          runs.back().program != sprite.program ||
+          runs.back().texture != sprite.texture ||
+          runs.back().layer != sprite.settings.layer ||
+          runs.back().blend != blend)
+        {
+          runs.push_back({draw_list::item_type::sprite, sprite.program,
+                          sprite.texture, sprite.settings.layer, blend,
+                          sprite_count, 0});
+        }
+      runs.back().count++;
+      sprite_count++;
+
+      transforms.push_back(sprite.settings);
+
+      const glm::vec2& lb{sprite.frame.left_bottom_uv};
+      const glm::vec2& rt{sprite.frame.right_top_uv};
+
+      out++->uv = lb;
+      out++->uv = {lb.x, rt.y};
+      out++->uv = {rt.x, lb.y};
+      out++->uv = rt;
+    }
+
+  if (sprite_count > 0)
+    {
+      sprite_transform::transform_quads(transforms, &vertices[0].position.x,
+                                        sizeof(vertex) / sizeof(float));
+      reserve_indices(sprite_count);
+      const unsigned int offset{vbo.stream(
+          static_cast<unsigned int>(vertices.size() * sizeof(vertex)),
+          vertices.data())};
+      vao.set_vertex_buffer_offset(vbo, descriptor, 0, offset);
+    }
+
+  for (const run& current : runs) draw_run(items, current);
+
+  items.clear();
+  runs.clear();
+  transforms.clear();
+  last_program = nullptr;
+}
+
+const sprite_batch::program_uniforms& sprite_batch::use_program(
+    shader_program& program)
+{
+  if (&program != last_program)
+    {
+      auto found = uniforms.find(&program);
+      // a program created at the address of a deleted one resolves anew
+      if (found == uniforms.end() || !program.owns(found->second.texture))
+        {
+          program_uniforms resolved{};
+          resolved.texture = program.get_uniform<int>("s_texture");
+          resolved.model = program.get_uniform<glm::mat4x4>("s_model");
+          resolved.layer = program.get_uniform<int>("s_layer");
+          found = uniforms.insert_or_assign(&program, resolved).first;
+        }
+      last_program = &program;
+      last_uniforms = &found->second;
+    }
+
+  program.use();
+  program.set(last_uniforms->texture, 0);
+  return *last_uniforms;
+}
+
+void sprite_batch::draw_run(const draw_list& items, const run& current)
+{
+  renderer::set_blend_mode(current.blend);
+  switch (current.type)
+    {
+      case draw_list::item_type::sprite:
+        {
+          const program_uniforms& program{use_program(*current.program)};
+          current.program->set(program.model, glm::mat4x4{1});
+          current.program->set(program.layer, current.layer);
+          texture2D::active_texture(0);
+          current.texture->bind();
+
+          renderer::draw(vao, ibo, *current.program,
+                         current.count * indices_per_sprite,
+                         current.first * indices_per_sprite);
+          break;
+        }
+      case draw_list::item_type::instances:
+        {
+          const draw_list::instances_item& item{
+              items.get_instances()[current.first]};
+          // the set caches its own handle, no lookup is needed
+          item.program->use();
+          item.program->set(item.texture_uniform, 0);
+          texture2D::active_texture(0);
+          item.texture->bind();
+
+          renderer::get_quad().draw(*item.program,
+                                    &items.get_instance_data()[item.first],
+                                    item.count);
+          break;
+        }
+      case draw_list::item_type::command:
+        items.get_command(current.first)();
+        break;
+    }
+}
+}  // namespace render
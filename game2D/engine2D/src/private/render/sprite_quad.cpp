@@ -0,0 +1,39 @@
+#include "render/sprite_quad.h"
+#include "render/renderer.h"
+#include "render/shader_program.h"
+namespace render
+{
+sprite_quad::sprite_quad()
+{
+  vao.bind();
+
+  float quad_pos[]{0, 0, 0, 1, 1, 0, 1, 1};
+  quad_vbo.restore(sizeof(quad_pos), quad_pos);
+
+  vertex_buffer_descriptor quad_descriptor{};
+  quad_descriptor.add_element_descriptor_float(2, false);
+  vao.bind_vertex_buffer(quad_vbo, quad_descriptor);
+
+  instance_descriptor.add_element_descriptor_float(4, false);
+  instance_descriptor.add_element_descriptor_float(2, false);
+  instance_descriptor.add_element_descriptor_float(4, false);
+  instance_descriptor.add_element_descriptor_float(4, false);
+  vao.bind_vertex_buffer(instance_vbo, instance_descriptor, 1);
+
+  unsigned int indices[]{1, 0, 2, 3};
+  vebo.restore(4, indices);
+}
+
+void sprite_quad::draw(const shader_program& program,
+                       const instance* instances, unsigned int count)
+{
+  if (count == 0) return;
+
+  const unsigned int offset{instance_vbo.stream(
+      count * static_cast<unsigned int>(sizeof(instance)), instances)};
+  // the quad corner is attribute 0, instance data starts from attribute 1
+  vao.set_vertex_buffer_offset(instance_vbo, instance_descriptor, 1, offset);
+
+  renderer::draw_instanced(vao, vebo, program, count, GL_TRIANGLE_FAN);
+}
+}  // namespace render
@@ -0,0 +1,177 @@
+#include "render/sprite_transform.h"
+#include <glm/trigonometric.hpp>
+#include <cmath>
+#include "render/simd.h"
+namespace render
+{
+namespace
+{
+using simd::float4;
+
+inline float4 operator&(float4 a, float4 b)
+{
+  return simd::select(a, b, simd::set(0.f));
+}
+
+/*!
+ * \brief Синус и косинус угла в градусах
+ * Угол приводится к [-pi/4; pi/4] с номером четверти, после чего значения
+ * вычисляются рядами Тейлора и восстанавливаются по четверти
+ */
+inline void sincos_degrees(float4 degrees, float4& sin, float4& cos)
+{
+  // the angle in quarter turns, reduced to [-2; 2]
+  float4 quarters{degrees * simd::set(1.f / 90.f)};
+  quarters = quarters -
+             simd::round(quarters * simd::set(0.25f)) * simd::set(4.f);
+
+  const float4 quadrant{simd::round(quarters)};
+  const float4 x{(quarters - quadrant) * simd::set(1.57079632679f)};
+  const float4 x2{x * x};
+
+  const float4 s{
+      x * (simd::set(1.f) +
+           x2 * (simd::set(-1.f / 6.f) +
+                 x2 * (simd::set(1.f / 120.f) + x2 * simd::set(-1.f / 5040.f))))};
+  const float4 c{
+      simd::set(1.f) +
+      x2 * (simd::set(-0.5f) +
+            x2 * (simd::set(1.f / 24.f) +
+                  x2 * (simd::set(-1.f / 720.f) +
+                        x2 * simd::set(1.f / 40320.f))))};
+
+  const float4 half{simd::set(0.5f)};
+  const float4 one_and_half{simd::set(1.5f)};
+  const float4 odd{((quadrant >= half) & (quadrant <= one_and_half)) |
+                   ((quadrant <= -half) & (quadrant >= -one_and_half))};
+  const float4 sin_negative{(quadrant <= -half) | (quadrant >= one_and_half)};
+  const float4 cos_negative{(quadrant >= half) | (quadrant <= -one_and_half)};
+
+  sin = simd::negate_if(sin_negative, simd::select(odd, c, s));
+  cos = simd::negate_if(cos_negative, simd::select(odd, s, c));
+}
+
+/*!
+ * \brief Преобразование четырех спрайтов
+ * \param count   количество действительных спрайтов в блоке
+ */
+inline void transform_block(const float* x, const float* y, const float* width,
+                            const float* height, const float* rotation,
+                            size_t count, float* corners, size_t stride)
+{
+  float4 sin{}, cos{};
+  sincos_degrees(simd::load(rotation), sin, cos);
+
+  const float4 half{simd::set(0.5f)};
+  const float4 half_width{simd::load(width) * half};
+  const float4 half_height{simd::load(height) * half};
+  const float4 center_x{simd::load(x) + half_width};
+  const float4 center_y{simd::load(y) + half_height};
+
+  const float4 axis_x_x{cos * half_width};
+  const float4 axis_x_y{sin * half_width};
+  const float4 axis_y_x{-(sin * half_height)};
+  const float4 axis_y_y{cos * half_height};
+
+  const float4 left_x{center_x - axis_x_x};
+  const float4 left_y{center_y - axis_x_y};
+  const float4 right_x{center_x + axis_x_x};
+  const float4 right_y{center_y + axis_x_y};
+
+  float result[8][4];
+  simd::store(result[0], left_x - axis_y_x);
+  simd::store(result[1], left_y - axis_y_y);
+  simd::store(result[2], left_x + axis_y_x);
+  simd::store(result[3], left_y + axis_y_y);
+  simd::store(result[4], right_x - axis_y_x);
+  simd::store(result[5], right_y - axis_y_y);
+  simd::store(result[6], right_x + axis_y_x);
+  simd::store(result[7], right_y + axis_y_y);
+
+  for (size_t sprite{0}; sprite < count; sprite++)
+    {
+      float* out{corners + sprite * 4 * stride};
+      for (size_t corner{0}; corner < 4; corner++)
+        {
+          out[corner * stride] = result[corner * 2][sprite];
+          out[corner * stride + 1] = result[corner * 2 + 1][sprite];
+        }
+    }
+}
+}  // namespace
+
+void sprite_transform_input::push_back(const render_settings& settings)
+{
+  x.push_back(settings.position.x);
+  y.push_back(settings.position.y);
+  width.push_back(settings.size.x);
+  height.push_back(settings.size.y);
+  rotation.push_back(settings.rotation);
+}
+
+void sprite_transform_input::clear()
+{
+  x.clear();
+  y.clear();
+  width.clear();
+  height.clear();
+  rotation.clear();
+}
+
+void sprite_transform::transform_quads(const sprite_transform_input& input,
+                                       float* corners, size_t stride)
+{
+  const size_t count{input.size()};
+  const size_t full_blocks{count / 4 * 4};
+
+  for (size_t first{0}; first < full_blocks; first += 4)
+    transform_block(&input.x[first], &input.y[first], &input.width[first],
+                    &input.height[first], &input.rotation[first], 4,
+                    corners + first * 4 * stride, stride);
+
+  if (full_blocks == count) return;
+
+  // the tail is padded to a full block
+  float tail[5][4]{};
+  const size_t tail_count{count - full_blocks};
+  for (size_t it{0}; it < tail_count; it++)
+    {
+      tail[0][it] = input.x[full_blocks + it];
+      tail[1][it] = input.y[full_blocks + it];
+      tail[2][it] = input.width[full_blocks + it];
+      tail[3][it] = input.height[full_blocks + it];
+      tail[4][it] = input.rotation[full_blocks + it];
+    }
+  transform_block(tail[0], tail[1], tail[2], tail[3], tail[4], tail_count,
+                  corners + full_blocks * 4 * stride, stride);
+}
+
+void sprite_transform::transform_quads_scalar(
+    const sprite_transform_input& input, float* corners, size_t stride)
+{
+  for (size_t sprite{0}; sprite < input.size(); sprite++)
+    {
+      const float angle{glm::radians(input.rotation[sprite])};
+      const float cos{std::cos(angle)};
+      const float sin{std::sin(angle)};
+      const float half_width{input.width[sprite] * 0.5f};
+      const float half_height{input.height[sprite] * 0.5f};
+      const float center_x{input.x[sprite] + half_width};
+      const float center_y{input.y[sprite] + half_height};
+
+      const float axis_x[2]{cos * half_width, sin * half_width};
+      const float axis_y[2]{-sin * half_height, cos * half_height};
+
+      float* out{corners + sprite * 4 * stride};
+      for (int corner{0}; corner < 4; corner++)
+        {
+          const float side_x{corner < 2 ? -1.f : 1.f};
+          const float side_y{corner % 2 == 0 ? -1.f : 1.f};
+          out[corner * stride] =
+              center_x + side_x * axis_x[0] + side_y * axis_y[0];
+          out[corner * stride + 1] =
+              center_y + side_x * axis_x[1] + side_y * axis_y[1];
+        }
+    }
+}
+}  // namespace render
@@ -0,0 +1,63 @@
+#include "render/uniform_buffer.h"
+#include <iostream>
+#include <utility>
+#include "render/renderer.h"
+
+namespace render
+{
+uniform_buffer::uniform_buffer(unsigned int binding_, unsigned int size_,
+                               buffer_usage usage_)
+    : binding{binding_}, size{size_}, usage{usage_}
+{
+  glGenBuffers(1, &id);
+  renderer::bind_buffer(buffer_type, id);
+  glBufferData(buffer_type, size, nullptr, to_gl_usage(usage));
+  bind_base();
+}
+
+void uniform_buffer::update(const unsigned int size_, const void* data)
+{
+  if (size_ > size)
+    {
+      std::cerr << "uniform_buffer: " << size_ << " bytes don't fit into a "
+                << size << " bytes buffer" << std::endl;
+      return;
+    }
+  renderer::bind_buffer(buffer_type, id);
+  // orphan the old storage, so the driver doesn't wait for draws using it
+  if (usage != buffer_usage::static_draw)
+    glBufferData(buffer_type, size, nullptr, to_gl_usage(usage));
+  glBufferSubData(buffer_type, 0, size_, data);
+}
+
+void uniform_buffer::bind_base() const
+{
+  renderer::bind_buffer_base(buffer_type, binding, id);
+}
+
+uniform_buffer::~uniform_buffer()
+{
+  renderer::forget_buffer(id);
+  glDeleteBuffers(1, &id);
+}
+
+uniform_buffer::uniform_buffer(uniform_buffer&& buffer)
+    : id{std::exchange(buffer.id, 0)},
+      binding{buffer.binding},
+      size{std::exchange(buffer.size, 0)},
+      usage{buffer.usage}
+{
+}
+
+uniform_buffer& uniform_buffer::operator=(uniform_buffer&& buffer)
+{
+  renderer::forget_buffer(id);
+  glDeleteBuffers(1, &id);
+
+  id = std::exchange(buffer.id, 0);
+  binding = buffer.binding;
+  size = std::exchange(buffer.size, 0);
+  usage = buffer.usage;
+  return *this;
+}
+}  // namespace render
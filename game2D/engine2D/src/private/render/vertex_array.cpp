@@ -1,4 +1,5 @@
 #include "render/vertex_array.h"
+#include "render/renderer.h"
 #include "render/vertex_buffer.h"
 #include "render/vertex_buffer_descriptor.h"
 namespace render
@@ -6,35 +7,59 @@ namespace render
 vertex_array::vertex_array()
 {
   glGenVertexArrays(1, &id);
-  glBindVertexArray(id);
+  bind();
 }
 
-void vertex_array::bind() const { glBindVertexArray(id); }
-void vertex_array::detach() const { glBindVertexArray(0); }
+void vertex_array::bind() const { renderer::bind_vertex_array(id); }
+void vertex_array::detach() const { renderer::bind_vertex_array(0); }
 
 void vertex_array::bind_vertex_buffer(
-    const vertex_buffer& buffer, const vertex_buffer_descriptor& descriptor)
+    const vertex_buffer& buffer, const vertex_buffer_descriptor& descriptor,
+    unsigned int divisor)
 {
-  glBindVertexArray(id);
+  bind();
   buffer.bind();
 
-  unsigned int descriptor_size{
+  const unsigned int first_attribute{va_arrays_count};
+  const unsigned int descriptor_size{
       static_cast<unsigned int>(descriptor.get_descriptors().size())};
 
-  auto& descriptors{descriptor.get_descriptors()};
-
-  GLbyte* offset{nullptr};
-
   for (unsigned int pointer{0}; pointer < descriptor_size; pointer++)
     {
+      glEnableVertexAttribArray(va_arrays_count);
+      glVertexAttribDivisor(va_arrays_count, divisor);
       va_arrays_count++;
-      auto& element{descriptors[pointer]};
-      offset += element.size;
+    }
+  set_attribute_pointers(descriptor, first_attribute, 0);
+}
 
-      glEnableVertexAttribArray(va_arrays_count);
-      glVertexAttribPointer(va_arrays_count, element.size, GL_FLOAT,
+void vertex_array::set_vertex_buffer_offset(
+    const vertex_buffer& buffer, const vertex_buffer_descriptor& descriptor,
+    unsigned int first_attribute, unsigned int offset)
+{
+  bind();
+  buffer.bind();
+  set_attribute_pointers(descriptor, first_attribute, offset);
+}
+
+void vertex_array::set_attribute_pointers(
+    const vertex_buffer_descriptor& descriptor, unsigned int first_attribute,
+    unsigned int offset)
+{
+  auto& descriptors{descriptor.get_descriptors()};
+
+  GLbyte* pointer_offset{nullptr};
+  pointer_offset += offset;
+
+  unsigned int attribute{first_attribute};
+  for (auto& element : descriptors)
+    {
+      glVertexAttribPointer(attribute, element.count, element.type,
                             element.normalized, descriptor.get_stride(),
-                            offset);
+                            pointer_offset);
+
+      pointer_offset += element.size;
+      attribute++;
     }
 }
 
@@ -45,6 +70,7 @@ vertex_array::vertex_array(vertex_array&& vao)
 }
 vertex_array& vertex_array::operator=(vertex_array&& vao)
 {
+  renderer::forget_vertex_array(id);
   glDeleteVertexArrays(1, &id);
 
   id = vao.id;
@@ -53,5 +79,9 @@ vertex_array& vertex_array::operator=(vertex_array&& vao)
   return *this;
 }
 
-vertex_array::~vertex_array() { glDeleteVertexArrays(1, &id); }
+vertex_array::~vertex_array()
+{
+  renderer::forget_vertex_array(id);
+  glDeleteVertexArrays(1, &id);
+}
 }  // namespace render
@@ -1,50 +1,171 @@
 #include "render/vertex_buffer.h"
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include "render/renderer.h"
 
 namespace render
 {
-vertex_buffer::vertex_buffer()
+namespace
+{
+// minimal ring segment size and alignment of streamed data
+constexpr unsigned int min_segment_size{64 * 1024};
+constexpr unsigned int stream_alignment{16};
+}  // namespace
+
+vertex_buffer::vertex_buffer(buffer_usage usage_) : usage{usage_}
 {
   glGenBuffers(1, &id);
   restore(0, nullptr);
 }
-vertex_buffer::vertex_buffer(const unsigned int size, const void* data)
+vertex_buffer::vertex_buffer(const unsigned int size, const void* data,
+                             buffer_usage usage_)
+    : usage{usage_}
 {
   glGenBuffers(1, &id);
   restore(size, data);
 }
 
-void vertex_buffer::bind() const { glBindBuffer(buffer_type, id); }
-void vertex_buffer::detach() const { glBindBuffer(buffer_type, 0); }
+void vertex_buffer::bind() const { renderer::bind_buffer(buffer_type, id); }
+void vertex_buffer::detach() const { renderer::bind_buffer(buffer_type, 0); }
 
 void vertex_buffer::update(const unsigned int size_, const void* data)
 {
-  glBindBuffer(buffer_type, id);
-  glBufferSubData(buffer_type, 0, size_, data);
+  bind();
   if (size_ > size) size = size_;
+  // orphan the old storage, so the driver doesn't wait for draws using it
+  if (usage != buffer_usage::static_draw)
+    glBufferData(buffer_type, size, nullptr, to_gl_usage(usage));
+  glBufferSubData(buffer_type, 0, size_, data);
+}
+
+void vertex_buffer::update_range(const unsigned int offset,
+                                 const unsigned int size_, const void* data)
+{
+  bind();
+  glBufferSubData(buffer_type, offset, size_, data);
+}
+
+unsigned int vertex_buffer::stream(const unsigned int size_, const void* data)
+{
+  unsigned int offset{(cursor + stream_alignment - 1) &
+                      ~(stream_alignment - 1)};
+  if (offset + size_ > segment_size)
+    {
+      // the new storage is unused, so the ring restarts without waiting
+      unsigned int new_size{segment_size == 0 ? min_segment_size
+                                              : segment_size * 2};
+      while (new_size < size_) new_size *= 2;
+
+      restore(new_size * ring_segments, nullptr);
+      segment_size = new_size;
+      offset = 0;
+    }
+  else if (cursor == 0)
+    wait_segment();
+
+  bind();
+  const unsigned int position{segment * segment_size + offset};
+  void* mapped{glMapBufferRange(
+      buffer_type, position, size_,
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+          GL_MAP_UNSYNCHRONIZED_BIT)};
+  if (mapped)
+    {
+      std::memcpy(mapped, data, size_);
+      glUnmapBuffer(buffer_type);
+    }
+  else
+    glBufferSubData(buffer_type, position, size_, data);
+
+  cursor = offset + size_;
+  return position;
+}
+
+void vertex_buffer::wait_segment()
+{
+  GLsync& fence{fences[segment]};
+  if (!fence) return;
+
+  if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+    {
+      renderer::current_stats().buffer_waits++;
+      GLenum result{GL_TIMEOUT_EXPIRED};
+      while (result == GL_TIMEOUT_EXPIRED)
+        result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                  1000000000);
+      if (result == GL_WAIT_FAILED)
+        std::cerr << "Failed to wait for a stream buffer segment" << std::endl;
+    }
+  glDeleteSync(fence);
+  fence = nullptr;
+}
+
+void vertex_buffer::end_frame()
+{
+  if (cursor == 0) return;
+
+  if (fences[segment]) glDeleteSync(fences[segment]);
+  fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  segment = (segment + 1) % ring_segments;
+  cursor = 0;
+}
+
+void vertex_buffer::release_fences()
+{
+  for (GLsync& fence : fences)
+    {
+      if (fence) glDeleteSync(fence);
+      fence = nullptr;
+    }
+  segment = 0;
+  cursor = 0;
 }
 
 vertex_buffer::vertex_buffer(vertex_buffer&& buffer)
+    : id{std::exchange(buffer.id, 0)},
+      size{std::exchange(buffer.size, 0)},
+      usage{buffer.usage},
+      segment_size{std::exchange(buffer.segment_size, 0)},
+      segment{std::exchange(buffer.segment, 0)},
+      cursor{std::exchange(buffer.cursor, 0)},
+      fences{std::exchange(buffer.fences, {})}
 {
-  id = buffer.id;
-  buffer.id = 0;
 }
 
 vertex_buffer& vertex_buffer::operator=(vertex_buffer&& buffer)
 {
+  release_fences();
+  renderer::forget_buffer(id);
   glDeleteBuffers(1, &id);
 
-  id = buffer.id;
-  buffer.id = 0;
+  id = std::exchange(buffer.id, 0);
+  size = std::exchange(buffer.size, 0);
+  usage = buffer.usage;
+  segment_size = std::exchange(buffer.segment_size, 0);
+  segment = std::exchange(buffer.segment, 0);
+  cursor = std::exchange(buffer.cursor, 0);
+  fences = std::exchange(buffer.fences, {});
 
   return *this;
 }
 
 void vertex_buffer::restore(const unsigned int size, const void* data)
 {
-  glBindBuffer(buffer_type, id);
-  glBufferData(buffer_type, size, data, GL_STATIC_DRAW);
+  // old segments are orphaned together with the storage
+  release_fences();
+  segment_size = 0;
+
+  bind();
+  glBufferData(buffer_type, size, data, to_gl_usage(usage));
   this->size = size;
 }
 
-vertex_buffer::~vertex_buffer() { glDeleteBuffers(1, &id); }
+vertex_buffer::~vertex_buffer()
+{
+  release_fences();
+  renderer::forget_buffer(id);
+  glDeleteBuffers(1, &id);
+}
 }  // namespace render
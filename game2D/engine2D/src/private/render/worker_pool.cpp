@@ -0,0 +1,82 @@
+#include "render/worker_pool.h"
+namespace render
+{
+worker_pool::worker_pool(unsigned int workers)
+{
+  threads.reserve(workers);
+  for (unsigned int it{0}; it < workers; it++)
+    threads.emplace_back(&worker_pool::work, this);
+}
+
+void worker_pool::run(unsigned int parts_,
+                      const std::function<void(unsigned int)>& task_)
+{
+  if (threads.empty() || parts_ < 2)
+    {
+      for (unsigned int part{0}; part < parts_; part++) task_(part);
+      return;
+    }
+
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    task = &task_;
+    parts = parts_;
+    next_part = 0;
+    finished_parts = 0;
+    generation++;
+  }
+  start.notify_all();
+
+  execute_parts();
+
+  std::unique_lock<std::mutex> lock{mutex};
+  done.wait(lock, [this]() { return finished_parts == parts; });
+  task = nullptr;
+}
+
+void worker_pool::execute_parts()
+{
+  for (;;)
+    {
+      const std::function<void(unsigned int)>* current{nullptr};
+      unsigned int part{0};
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!task || next_part >= parts) return;
+        current = task;
+        part = next_part++;
+      }
+
+      (*current)(part);
+
+      std::lock_guard<std::mutex> lock{mutex};
+      if (++finished_parts == parts) done.notify_all();
+    }
+}
+
+void worker_pool::work()
+{
+  unsigned long long seen{0};
+  for (;;)
+    {
+      {
+        std::unique_lock<std::mutex> lock{mutex};
+        start.wait(lock,
+                   [&seen, this]() { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+      }
+      execute_parts();
+    }
+}
+
+worker_pool::~worker_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    stopping = true;
+  }
+  start.notify_all();
+  for (std::thread& thread : threads) thread.join();
+}
+}  // namespace render
@@ -0,0 +1,318 @@
+#include "resources/ktx_loader.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+namespace resources
+{
+namespace
+{
+const unsigned char ktx1_identifier[12]{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31,
+                                        0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+const unsigned char ktx2_identifier[12]{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                        0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+// vulkan formats used by KTX2
+enum vk_format : std::uint32_t
+{
+  vk_r4g4b4a4_unorm_pack16 = 2,
+  vk_r5g6b5_unorm_pack16 = 4,
+  vk_r8g8b8_unorm = 23,
+  vk_r8g8b8a8_unorm = 37,
+  vk_etc2_r8g8b8_unorm_block = 147,
+  vk_etc2_r8g8b8a1_unorm_block = 149,
+  vk_etc2_r8g8b8a8_unorm_block = 151,
+  vk_eac_r11_unorm_block = 153,
+  vk_eac_r11g11_unorm_block = 155
+};
+
+template <typename T>
+bool read(const std::string& data, size_t offset, T& value)
+{
+  if (offset + sizeof(T) > data.size()) return false;
+  std::memcpy(&value, data.data() + offset, sizeof(T));
+  return true;
+}
+
+size_t align4(size_t value) { return (value + 3) & ~size_t{3}; }
+
+/*!
+ * \brief Поиск значения ключа в блоке ключей-значений
+ * \return Значение ключа, пустая строка - ключ не найден
+ */
+std::string find_value(const std::string& data, size_t offset, size_t size,
+                       const std::string& key)
+{
+  const size_t end{std::min(offset + size, data.size())};
+  while (offset + 4 <= end)
+    {
+      std::uint32_t length{0};
+      read(data, offset, length);
+      offset += 4;
+      if (offset + length > end) break;
+
+      const std::string entry{data, offset, length};
+      const size_t separator{entry.find('\0')};
+      if (separator != std::string::npos && entry.substr(0, separator) == key)
+        {
+          std::string value{entry.substr(separator + 1)};
+          value.erase(std::find(value.begin(), value.end(), '\0'), value.end());
+          return value;
+        }
+      offset = align4(offset + length);
+    }
+  return "";
+}
+
+/*!
+ * \brief Добавление уровня детализации
+ * \param alignment   выравнивание строк несжатых данных в файле, строки с
+ * выравниванием копируются в плотно упакованный буфер
+ */
+bool add_level(const std::string& data, ktx_loader::image& result, int width,
+               int height, size_t level, size_t offset, size_t size,
+               size_t alignment)
+{
+  // offset + size may wrap for 64-bit KTX2 values
+  if (offset > data.size() || size > data.size() - offset)
+    {
+      std::cerr << "ktx_loader: level " << level << " is out of the file"
+                << std::endl;
+      return false;
+    }
+  const int level_width{std::max(1, width >> level)};
+  const int level_height{std::max(1, height >> level)};
+  const size_t row{render::texture2D::get_image_size(level_width, 1,
+                                                     result.format)};
+  const size_t stride{render::texture2D::is_compressed(result.format)
+                          ? row
+                          : (row + alignment - 1) / alignment * alignment};
+  const size_t rows{static_cast<size_t>(level_height)};
+  if (stride == row)
+    {
+      if (size < render::texture2D::get_image_size(level_width, level_height,
+                                                   result.format))
+        {
+          std::cerr << "ktx_loader: level " << level << " is too small"
+                    << std::endl;
+          return false;
+        }
+      result.levels.push_back(
+          {level_width, level_height, data.data() + offset, size});
+      return true;
+    }
+
+  // the last row may go without padding
+  if (size < stride * (rows - 1) + row)
+    {
+      std::cerr << "ktx_loader: level " << level << " is too small"
+                << std::endl;
+      return false;
+    }
+  std::vector<unsigned char>& packed{
+      result.packed_levels.emplace_back(row * rows)};
+  for (size_t line{0}; line < rows; line++)
+    std::memcpy(packed.data() + row * line,
+                data.data() + offset + stride * line, row);
+  result.levels.push_back(
+      {level_width, level_height, packed.data(), packed.size()});
+  return true;
+}
+}  // namespace
+
+bool ktx_loader::parse(const std::string& data, image& result)
+{
+  result = image{};
+  if (data.size() >= 12 &&
+      std::memcmp(data.data(), ktx1_identifier, 12) == 0)
+    return parse_ktx1(data, result);
+  if (data.size() >= 12 &&
+      std::memcmp(data.data(), ktx2_identifier, 12) == 0)
+    return parse_ktx2(data, result);
+
+  std::cerr << "ktx_loader: unknown file identifier" << std::endl;
+  return false;
+}
+
+bool ktx_loader::parse_ktx1(const std::string& data, image& result)
+{
+  std::uint32_t header[13]{};
+  if (!read(data, 12, header))
+    {
+      std::cerr << "ktx_loader: truncated KTX header" << std::endl;
+      return false;
+    }
+  const std::uint32_t endianness{header[0]}, gl_type{header[1]},
+      gl_format{header[3]}, gl_internal_format{header[4]},
+      width{header[6]}, height{header[7]}, depth{header[8]},
+      array_elements{header[9]}, faces{header[10]}, levels{header[11]},
+      key_value_size{header[12]};
+
+  if (endianness != 0x04030201)
+    {
+      std::cerr << "ktx_loader: big-endian KTX files are not supported"
+                << std::endl;
+      return false;
+    }
+  if (depth > 1 || array_elements > 0 || faces != 1 || width == 0 ||
+      height == 0)
+    {
+      std::cerr << "ktx_loader: only 2D textures are supported" << std::endl;
+      return false;
+    }
+
+  if (gl_type == 0)
+    {
+      switch (gl_internal_format)
+        {
+          case GL_COMPRESSED_RGB8_ETC2:
+            result.format = render::color_format::etc2_rgb;
+            break;
+          case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            result.format = render::color_format::etc2_rgb_a1;
+            break;
+          case GL_COMPRESSED_RGBA8_ETC2_EAC:
+            result.format = render::color_format::etc2_rgba;
+            break;
+          case GL_COMPRESSED_R11_EAC:
+            result.format = render::color_format::eac_r11;
+            break;
+          case GL_COMPRESSED_RG11_EAC:
+            result.format = render::color_format::eac_rg11;
+            break;
+          default:
+            std::cerr << "ktx_loader: unsupported compressed format 0x"
+                      << std::hex << gl_internal_format << std::dec
+                      << std::endl;
+            return false;
+        }
+    }
+  else if (gl_type == GL_UNSIGNED_BYTE && gl_format == GL_RGB)
+    result.format = render::color_format::rgb;
+  else if (gl_type == GL_UNSIGNED_BYTE && gl_format == GL_RGBA)
+    result.format = render::color_format::rgba;
+  else if (gl_type == GL_UNSIGNED_SHORT_5_6_5 && gl_format == GL_RGB)
+    result.format = render::color_format::rgb565;
+  else if (gl_type == GL_UNSIGNED_SHORT_4_4_4_4 && gl_format == GL_RGBA)
+    result.format = render::color_format::rgba4444;
+  else
+    {
+      std::cerr << "ktx_loader: unsupported format 0x" << std::hex << gl_format
+                << " type 0x" << gl_type << std::dec << std::endl;
+      return false;
+    }
+
+  const size_t key_value_offset{64};
+  result.bottom_up =
+      find_value(data, key_value_offset, key_value_size, "KTXorientation")
+          .find("T=u") != std::string::npos;
+
+  // zero levels ask the loader to build the mipmap chain
+  result.generate_mipmaps = levels == 0;
+  size_t offset{key_value_offset + key_value_size};
+  for (size_t level{0}; level < std::max<std::uint32_t>(levels, 1); level++)
+    {
+      std::uint32_t size{0};
+      if (!read(data, offset, size))
+        {
+          std::cerr << "ktx_loader: truncated KTX level " << level
+                    << std::endl;
+          return false;
+        }
+      offset += 4;
+      // KTX 1.1 pads uncompressed rows to GL_UNPACK_ALIGNMENT = 4
+      if (!add_level(data, result, static_cast<int>(width),
+                     static_cast<int>(height), level, offset, size, 4))
+        return false;
+      offset = align4(offset + size);
+    }
+  return true;
+}
+
+bool ktx_loader::parse_ktx2(const std::string& data, image& result)
+{
+  std::uint32_t header[9]{};
+  std::uint32_t index[4]{};
+  if (!read(data, 12, header) || !read(data, 48, index))
+    {
+      std::cerr << "ktx_loader: truncated KTX2 header" << std::endl;
+      return false;
+    }
+  const std::uint32_t format{header[0]}, width{header[2]}, height{header[3]},
+      depth{header[4]}, layers{header[5]}, faces{header[6]},
+      levels{header[7]}, supercompression{header[8]};
+  const std::uint32_t key_value_offset{index[2]}, key_value_size{index[3]};
+
+  if (depth > 0 || layers > 0 || faces != 1 || width == 0 || height == 0)
+    {
+      std::cerr << "ktx_loader: only 2D textures are supported" << std::endl;
+      return false;
+    }
+  if (supercompression != 0)
+    {
+      std::cerr << "ktx_loader: supercompressed KTX2 files are not supported"
+                << std::endl;
+      return false;
+    }
+
+  switch (format)
+    {
+      case vk_r4g4b4a4_unorm_pack16:
+        result.format = render::color_format::rgba4444;
+        break;
+      case vk_r5g6b5_unorm_pack16:
+        result.format = render::color_format::rgb565;
+        break;
+      case vk_r8g8b8_unorm:
+        result.format = render::color_format::rgb;
+        break;
+      case vk_r8g8b8a8_unorm:
+        result.format = render::color_format::rgba;
+        break;
+      case vk_etc2_r8g8b8_unorm_block:
+        result.format = render::color_format::etc2_rgb;
+        break;
+      case vk_etc2_r8g8b8a1_unorm_block:
+        result.format = render::color_format::etc2_rgb_a1;
+        break;
+      case vk_etc2_r8g8b8a8_unorm_block:
+        result.format = render::color_format::etc2_rgba;
+        break;
+      case vk_eac_r11_unorm_block:
+        result.format = render::color_format::eac_r11;
+        break;
+      case vk_eac_r11g11_unorm_block:
+        result.format = render::color_format::eac_rg11;
+        break;
+      default:
+        std::cerr << "ktx_loader: unsupported vkFormat " << format
+                  << std::endl;
+        return false;
+    }
+
+  const std::string orientation{
+      find_value(data, key_value_offset, key_value_size, "KTXorientation")};
+  result.bottom_up = orientation.size() > 1 && orientation[1] == 'u';
+
+  result.generate_mipmaps = levels == 0;
+  // the level index starts right after the header
+  const size_t level_index{80};
+  for (size_t level{0}; level < std::max<std::uint32_t>(levels, 1); level++)
+    {
+      std::uint64_t level_offset{0}, level_size{0};
+      if (!read(data, level_index + level * 24, level_offset) ||
+          !read(data, level_index + level * 24 + 8, level_size))
+        {
+          std::cerr << "ktx_loader: truncated KTX2 level index" << std::endl;
+          return false;
+        }
+      if (!add_level(data, result, static_cast<int>(width),
+                     static_cast<int>(height), level,
+                     static_cast<size_t>(level_offset),
+                     static_cast<size_t>(level_size), 1))
+        return false;
+    }
+  return true;
+}
+}  // namespace resources
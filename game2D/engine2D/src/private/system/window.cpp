@@ -19,9 +19,11 @@ bool window_impl::init()
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 0);
   SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_ES);
 
+  Uint32 flags{SDL_WINDOW_OPENGL};
+  if (properties.headless) flags |= SDL_WINDOW_HIDDEN;
   data.window = SDL_CreateWindow(
       properties.title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-      properties.width, properties.height, SDL_WINDOW_OPENGL);
+      properties.width, properties.height, flags);
 
   if (!data.window)
     {
@@ -51,8 +53,29 @@ bool window_impl::init()
       return false;
     }
 
-  glEnable(GL_DEPTH_TEST);
+  render::renderer::init(properties.sprite_batching);
+  if (properties.headless &&
+      !render::renderer::create_offscreen_target(properties.width,
+                                                 properties.height))
+    {
+      std::cerr << "window inicializer:: Failed to create offscreen target"
+                << std::endl;
+      render::renderer::dispose();
+      SDL_GL_DeleteContext(data.gl_context);
+      SDL_DestroyWindow(data.window);
+      return false;
+    }
+  render::renderer::set_depth_test(true);
+  // sprites of one layer share the depth, later ones are drawn over
+  render::renderer::set_depth_func(GL_LEQUAL);
   render::renderer::clear_color(0.f, 0.f, 0.f, 0.f);
+  int drawable_width{properties.width}, drawable_height{properties.height};
+  if (!properties.headless)
+    SDL_GL_GetDrawableSize(data.window, &drawable_width, &drawable_height);
+  render::renderer::set_viewport(0, 0, drawable_width, drawable_height);
+  if (properties.dynamic_resolution)
+    render::renderer::set_dynamic_resolution(true, properties.frame_budget_ms,
+                                             properties.min_resolution_scale);
   /// TODO
   std::clog << "window inicializer::inicialization completed" << std::endl;
   data.initialized = true;
@@ -74,9 +97,29 @@ window_impl::window_impl(window_impl&& window)
 void window_impl::swap_buffers()
 {
   assert(data.initialized);
+  // nothing is presented, frames stay in the offscreen target
+  if (properties.headless) return;
   SDL_GL_SwapWindow(data.window);
 }
 
+bool window_impl::make_current()
+{
+  assert(data.initialized);
+  if (SDL_GL_MakeCurrent(data.window, data.gl_context) != 0)
+    {
+      std::cerr << "window:: Failed to make the context current: "
+                << SDL_GetError() << std::endl;
+      return false;
+    }
+  return true;
+}
+
+void window_impl::release_context()
+{
+  assert(data.initialized);
+  SDL_GL_MakeCurrent(data.window, nullptr);
+}
+
 window_impl& window_impl::operator=(window_impl&& window)
 {
   if (data.initialized)
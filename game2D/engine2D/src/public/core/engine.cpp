@@ -1,11 +1,13 @@
 #include <core/engine.h>
 #include <core/engine_impl.h>
+#include <core/ifixed_step_game.h>
 #include <core/igame.h>
 #include <glad/glad.h>
 #include <render/renderer.h>
 #include <sound/sound_buffer.h>
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstring>
 #include <iostream>
 #include <string>
@@ -17,6 +19,12 @@ std::unique_ptr<engine::engine_impl> engine::impl{nullptr};
 bool engine::init(const window_properties& window_prop,
                   const audio_properties& audio_prop)
 {
+  if (window_prop.headless)
+    {
+      // keeps drivers chosen through the environment
+      SDL_setenv("SDL_VIDEODRIVER", "offscreen", 0);
+      SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    }
   const int init_result = SDL_Init(
       SDL_INIT_TIMER | SDL_INIT_AUDIO | SDL_INIT_VIDEO | SDL_INIT_EVENTS |
       SDL_INIT_JOYSTICK | SDL_INIT_HAPTIC | SDL_INIT_GAMECONTROLLER);
@@ -61,6 +69,7 @@ void engine::dispose()
                 << std::endl;
       return;
     }
+  render::renderer::dispose();
   impl.release();
   SDL_Quit();
   initialized = false;
@@ -81,7 +90,35 @@ void engine::launch(igame& game)
                 << std::endl;
       return;
     }
-  auto last_time = std::chrono::high_resolution_clock::now();
+  // the game thread only records frames, the render thread owns the context
+  const bool threaded{impl->window.get_properties().render_thread};
+  if (threaded)
+    {
+      impl->window.release_context();
+      render::renderer::start_thread([]() { impl->window.make_current(); },
+                                     []() { impl->window.swap_buffers(); },
+                                     []() { impl->window.release_context(); });
+    }
+
+  // games with a fixed simulation step opt in through the sub-interface
+  ifixed_step_game* fixed_game{dynamic_cast<ifixed_step_game*>(&game)};
+  fixed_step_settings fixed_step{};
+  if (fixed_game)
+    {
+      fixed_step = fixed_game->get_fixed_step();
+      if (fixed_step.tick_rate <= 0.0)
+        {
+          std::cerr << "engine:: launch: invalid tick rate "
+                    << fixed_step.tick_rate << ", 60 is used" << std::endl;
+          fixed_step.tick_rate = 60.0;
+        }
+      fixed_step.max_steps = std::max(fixed_step.max_steps, 1u);
+    }
+  const double tick{1000.0 / fixed_step.tick_rate};
+  double accumulator{0.0};
+
+  const auto start_time = std::chrono::high_resolution_clock::now();
+  auto last_time = start_time;
   while (game.is_playing())
     {
       auto current_time = std::chrono::high_resolution_clock::now();
@@ -90,18 +127,70 @@ void engine::launch(igame& game)
               .count();
       last_time = current_time;
 
+      render::renderer::begin_frame();
+
       game.read_input(duration);
-      game.update_data(duration);
+      if (fixed_game)
+        {
+          accumulator += duration;
+          unsigned int steps{0};
+          for (; accumulator >= tick && steps < fixed_step.max_steps; steps++)
+            {
+              game.update_data(tick);
+              accumulator -= tick;
+            }
+          // a hitch drops the steps it can't catch up with
+          if (accumulator >= tick) accumulator = std::fmod(accumulator, tick);
+        }
+      else
+        game.update_data(duration);
+
+      if (!threaded) render::renderer::clear();
 
-      render::renderer::clear();
+      render::renderer::update_frame_data(
+          std::chrono::duration<float>(current_time - start_time).count(),
+          static_cast<float>(duration / 1000.0));
+      if (fixed_game)
+        fixed_game->render_output(accumulator / tick);
+      else
+        game.render_output();
+      render::renderer::end_frame();
 
-      game.render_output();
+      if (!threaded) impl->window.swap_buffers();
+    }
 
-      impl->window.swap_buffers();
+  if (threaded)
+    {
+      render::renderer::stop_thread();
+      impl->window.make_current();
     }
 }
 
 window& engine::get_window() { return impl->window; }
 audio& engine::get_audio() { return impl->audio; }
 
+render::camera2D& engine::get_camera()
+{
+  return render::renderer::get_camera();
+}
+
+const render::frame_stats& engine::get_frame_stats()
+{
+  return render::renderer::get_stats();
+}
+
+void engine::capture_frame() { render::renderer::request_capture(); }
+
+bool engine::get_captured_frame(std::vector<unsigned char>& rgba, int& width,
+                                int& height)
+{
+  return render::renderer::take_capture(rgba, width, height);
+}
+
+void engine::set_post_process(
+    const std::vector<render::post_process_pass>& passes, bool profile)
+{
+  render::renderer::set_post_process(passes, profile);
+}
+
 }  // namespace core
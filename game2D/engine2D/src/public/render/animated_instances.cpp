@@ -0,0 +1,235 @@
+#include <render/animated_instances.h>
+#include <render/animated_instances_impl.h>
+#include <algorithm>
+#include <limits>
+#include <glm/geometric.hpp>
+#include "render/renderer.h"
+#include "render/shader_program.h"
+#include "render/texture2D.h"
+namespace render
+{
+animated_instances::instances_impl::gpu_state::gpu_state()
+{
+  vao.bind();
+
+  float quad_pos[]{0, 0, 0, 1, 1, 0, 1, 1};
+  quad_vbo.restore(sizeof(quad_pos), quad_pos);
+
+  vertex_buffer_descriptor quad_descriptor{};
+  quad_descriptor.add_element_descriptor_float(2, false);
+  vao.bind_vertex_buffer(quad_vbo, quad_descriptor);
+
+  instance_vbo.restore(sizeof(instance), nullptr);
+  vertex_buffer_descriptor instance_descriptor{};
+  instance_descriptor.add_element_descriptor_float(4, false);
+  instance_descriptor.add_element_descriptor_float(2, false);
+  instance_descriptor.add_element_descriptor_float(2, false);
+  vao.bind_vertex_buffer(instance_vbo, instance_descriptor, 1);
+
+  unsigned int indices[]{1, 0, 2, 3};
+  vebo.restore(4, indices);
+
+  glGenTextures(1, &table);
+  renderer::bind_texture(table);
+  // the table is read with texelFetch, float textures are not filterable
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+}
+
+animated_instances::instances_impl::gpu_state::~gpu_state()
+{
+  renderer::forget_texture(table);
+  glDeleteTextures(1, &table);
+}
+
+std::vector<glm::vec4> animated_instances::instances_impl::build_table() const
+{
+  std::vector<glm::vec4> table(clips.size());
+  for (size_t clip{0}; clip < clips.size(); clip++)
+    {
+      const float first{static_cast<float>(table.size())};
+      float end{0};
+      bool hold{false};
+      for (const sprite_animator::frame& frame : clips[clip])
+        {
+          table.push_back(
+              {frame.discriptor.left_bottom_uv, frame.discriptor.right_top_uv});
+          // a negative duration stops the clip on its frame for good
+          if (frame.duration < 0) hold = true;
+          if (!hold) end += static_cast<float>(frame.duration / 1000.0);
+          table.push_back(
+              {hold ? std::numeric_limits<float>::max() : end, 0.f, 0.f, 0.f});
+        }
+
+      // a clip without duration stays on its first frame
+      const float count{end > 0.f || hold
+                            ? static_cast<float>(clips[clip].size())
+                            : 1.f};
+      table[clip] = {first, count, end, hold ? 1.f : 0.f};
+    }
+  return table;
+}
+
+void animated_instances::instances_impl::draw(
+    shader_program& program, texture2D& atlas, unsigned int count,
+    const std::vector<glm::vec4>& table, const std::vector<instance>& uploads)
+{
+  if (!gpu) gpu = std::make_unique<gpu_state>();
+
+  if (!table.empty())
+    {
+      const unsigned int texels{static_cast<unsigned int>(table.size())};
+      const unsigned int rows{(texels + table_width - 1) / table_width};
+      std::vector<glm::vec4> padded{table};
+      padded.resize(static_cast<size_t>(rows) * table_width, glm::vec4{0});
+
+      renderer::bind_texture(gpu->table);
+      glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, table_width, rows, 0, GL_RGBA,
+                   GL_FLOAT, padded.data());
+    }
+  if (!uploads.empty())
+    gpu->instance_vbo.restore(
+        static_cast<unsigned int>(uploads.size() * sizeof(instance)),
+        uploads.data());
+
+  if (!uniforms_resolved)
+    {
+      uniforms_resolved = true;
+      texture = program.get_uniform<int>("s_texture");
+      animation_table = program.get_uniform<int>("s_animation_table");
+    }
+
+  program.use();
+  program.set(texture, 0);
+  program.set(animation_table, 1);
+  texture2D::active_texture(1);
+  renderer::bind_texture(gpu->table);
+  texture2D::active_texture(0);
+  atlas.bind();
+
+  renderer::draw_instanced(gpu->vao, gpu->vebo, program, count,
+                           GL_TRIANGLE_FAN);
+}
+
+animated_instances::animated_instances(
+    std::shared_ptr<texture2D> texture_,
+    std::shared_ptr<shader_program> program_)
+    : program{program_}, texture{texture_}
+{
+  impl = std::make_unique<instances_impl>();
+}
+
+animated_instances::clip_id animated_instances::add_clip(
+    const std::vector<sprite_animator::frame>& frames)
+{
+  std::vector<sprite_animator::frame>& clip{impl->clips.emplace_back(frames)};
+  if (clip.empty()) clip.push_back({frame_descriptor{}, 0.0});
+  impl->table_dirty = true;
+  return static_cast<clip_id>(impl->clips.size() - 1);
+}
+
+unsigned int animated_instances::add(clip_id clip,
+                                     const render_settings& settings,
+                                     double offset)
+{
+  impl->instances.emplace_back();
+  const unsigned int instance{
+      static_cast<unsigned int>(impl->instances.size() - 1)};
+  set_settings(instance, settings);
+  play(instance, clip, offset);
+  return instance;
+}
+
+void animated_instances::play(unsigned int instance, clip_id clip,
+                              double offset)
+{
+  impl->instances[instance].clip_start = {
+      static_cast<float>(clip),
+      renderer::get_time() - static_cast<float>(offset / 1000.0)};
+  impl->instances_dirty = true;
+}
+
+void animated_instances::set_settings(unsigned int instance,
+                                      const render_settings& settings)
+{
+  instances_impl::instance& current{impl->instances[instance]};
+  current.position_size = {settings.position, settings.size};
+  current.rotation_layer = {settings.rotation,
+                            static_cast<float>(settings.layer)};
+  impl->instances_dirty = true;
+  impl->bounds_dirty = true;
+}
+
+void animated_instances::set_blend(blend_mode blend) { impl->blend = blend; }
+
+void animated_instances::clear()
+{
+  impl->instances.clear();
+  impl->instances_dirty = true;
+  impl->bounds_dirty = true;
+}
+
+size_t animated_instances::get_count() const { return impl->instances.size(); }
+
+void animated_instances::render()
+{
+  if (impl->instances.empty()) return;
+
+  if (impl->bounds_dirty)
+    {
+      impl->bounds_dirty = false;
+      impl->bounds_min = glm::vec2{std::numeric_limits<float>::max()};
+      impl->bounds_max = glm::vec2{std::numeric_limits<float>::lowest()};
+      impl->min_layer = std::numeric_limits<int>::max();
+      for (const instances_impl::instance& current : impl->instances)
+        {
+          // a circle around the center holds the quad at any rotation
+          const glm::vec2 size{current.position_size.z,
+                               current.position_size.w};
+          const glm::vec2 center{
+              glm::vec2{current.position_size.x, current.position_size.y} +
+              size * 0.5f};
+          const float radius{glm::length(size) * 0.5f};
+          impl->bounds_min = glm::min(impl->bounds_min, center - radius);
+          impl->bounds_max = glm::max(impl->bounds_max, center + radius);
+          impl->min_layer = std::min(
+              impl->min_layer, static_cast<int>(current.rotation_layer.y));
+        }
+    }
+
+  const unsigned int count{static_cast<unsigned int>(impl->instances.size())};
+  if (!renderer::get_camera().is_visible(impl->bounds_min,
+                                         impl->bounds_max - impl->bounds_min))
+    {
+      renderer::current_stats().culled_sprites += count;
+      return;
+    }
+  renderer::current_stats().drawn_sprites += count;
+
+  std::vector<glm::vec4> table{};
+  if (impl->table_dirty)
+    {
+      impl->table_dirty = false;
+      table = impl->build_table();
+    }
+  std::vector<instances_impl::instance> uploads{};
+  if (impl->instances_dirty)
+    {
+      impl->instances_dirty = false;
+      uploads = impl->instances;
+    }
+
+  renderer::submit_command(
+      impl->min_layer, impl->blend,
+      [impl{impl.get()}, program{program}, texture{texture}, count,
+       table{std::move(table)}, uploads{std::move(uploads)}]() {
+        impl->draw(*program, *texture, count, table, uploads);
+      });
+}
+
+animated_instances::~animated_instances() {}
+
+animated_instances::animated_instances(animated_instances&&) = default;
+animated_instances& animated_instances::operator=(animated_instances&&) =
+    default;
+}  // namespace render
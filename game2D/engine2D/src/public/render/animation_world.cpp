@@ -0,0 +1,218 @@
+#include <render/animation_world.h>
+#include <render/animation_world_impl.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "render/renderer.h"
+#include "render/shader_program.h"
+#include "render/texture2D.h"
+namespace render
+{
+void animation_world::world_impl::seek(const clip_data& data, float& time,
+                                       std::uint32_t& frame,
+                                       std::uint8_t& playing)
+{
+  if (time >= data.duration || time < 0.f)
+    {
+      if (data.clip.looped)
+        {
+          time = std::fmod(time, data.duration);
+          if (time < 0.f) time += data.duration;
+          // a tiny negative time plus the duration rounds up to it
+          if (time >= data.duration) time = 0.f;
+        }
+      else
+        {
+          const bool past_end{time >= data.duration};
+          time = past_end ? data.duration : 0.f;
+          frame = past_end ? static_cast<std::uint32_t>(
+                                 data.frame_ends.size() - 1)
+                           : 0;
+          playing = 0;
+          return;
+        }
+    }
+
+  // the time went backwards or wrapped around
+  if (frame > 0 && time < data.frame_ends[frame - 1]) frame = 0;
+  while (time >= data.frame_ends[frame]) frame++;
+}
+
+animation_world::animation_world()
+{
+  impl = std::make_unique<world_impl>();
+}
+
+animation_world::clip_id animation_world::add_clip(const animation_clip& clip)
+{
+  if (!clip.texture || !clip.program)
+    std::cerr << "animation_world:: clip without texture or program is not "
+                 "rendered"
+              << std::endl;
+
+  world_impl::clip_data& data{impl->clips.emplace_back()};
+  data.clip = clip;
+  if (data.clip.frames.empty()) data.clip.frames.push_back(frame_descriptor{});
+  if (data.clip.durations.size() != data.clip.frames.size())
+    {
+      std::cerr << "animation_world:: clip has " << data.clip.frames.size()
+                << " frames, but " << data.clip.durations.size()
+                << " durations" << std::endl;
+      data.clip.durations.resize(data.clip.frames.size(), 0.0);
+    }
+
+  float end{0};
+  for (double& duration : data.clip.durations)
+    {
+      duration = std::max(duration, 0.0);
+      end += static_cast<float>(duration);
+      data.frame_ends.push_back(end);
+    }
+  data.duration = end;
+
+  return static_cast<clip_id>(impl->clips.size() - 1);
+}
+
+const animation_clip& animation_world::get_clip(clip_id clip) const
+{
+  return impl->clips[clip].clip;
+}
+
+double animation_world::get_clip_duration(clip_id clip) const
+{
+  return impl->clips[clip].duration;
+}
+
+animation_world::instance_id animation_world::create(
+    clip_id clip, const render_settings& settings)
+{
+  assert(clip < impl->clips.size() && "unknown clip id");
+  instance_id instance{0};
+  if (!impl->free_ids.empty())
+    {
+      instance = impl->free_ids.back();
+      impl->free_ids.pop_back();
+    }
+  else
+    {
+      instance = static_cast<instance_id>(impl->dense_index.size());
+      impl->dense_index.push_back(world_impl::no_instance);
+    }
+
+  impl->dense_index[instance] = static_cast<unsigned int>(impl->time.size());
+  impl->clip.push_back(clip);
+  impl->time.push_back(0.f);
+  impl->speed.push_back(1.f);
+  impl->frame.push_back(0);
+  impl->playing.push_back(1);
+  impl->settings.push_back(settings);
+  impl->owner.push_back(instance);
+  return instance;
+}
+
+void animation_world::destroy(instance_id instance)
+{
+  const unsigned int index{impl->index_of(instance)};
+  const unsigned int last{static_cast<unsigned int>(impl->time.size() - 1)};
+
+  // the last element takes the place of the removed one
+  impl->clip[index] = impl->clip[last];
+  impl->time[index] = impl->time[last];
+  impl->speed[index] = impl->speed[last];
+  impl->frame[index] = impl->frame[last];
+  impl->playing[index] = impl->playing[last];
+  impl->settings[index] = impl->settings[last];
+  impl->owner[index] = impl->owner[last];
+  impl->dense_index[impl->owner[index]] = index;
+
+  impl->clip.pop_back();
+  impl->time.pop_back();
+  impl->speed.pop_back();
+  impl->frame.pop_back();
+  impl->playing.pop_back();
+  impl->settings.pop_back();
+  impl->owner.pop_back();
+
+  impl->dense_index[instance] = world_impl::no_instance;
+  impl->free_ids.push_back(instance);
+}
+
+void animation_world::play(instance_id instance, clip_id clip, bool restart)
+{
+  assert(clip < impl->clips.size() && "unknown clip id");
+  const unsigned int index{impl->index_of(instance)};
+  impl->clip[index] = clip;
+  impl->frame[index] = 0;
+  impl->playing[index] = 1;
+  if (restart)
+    impl->time[index] = 0.f;
+  else if (impl->clips[clip].duration > 0.f)
+    world_impl::seek(impl->clips[clip], impl->time[index],
+                     impl->frame[index], impl->playing[index]);
+}
+
+void animation_world::set_paused(instance_id instance, bool paused)
+{
+  impl->playing[impl->index_of(instance)] = paused ? 0 : 1;
+}
+
+void animation_world::set_speed(instance_id instance, float speed)
+{
+  impl->speed[impl->index_of(instance)] = speed;
+}
+
+render_settings& animation_world::get_settings(instance_id instance)
+{
+  return impl->settings[impl->index_of(instance)];
+}
+
+unsigned int animation_world::get_frame(instance_id instance) const
+{
+  return impl->frame[impl->index_of(instance)];
+}
+
+bool animation_world::is_playing(instance_id instance) const
+{
+  return impl->playing[impl->index_of(instance)] != 0;
+}
+
+void animation_world::update(double duration)
+{
+  const float delta{static_cast<float>(duration)};
+  const world_impl::clip_data* clips{impl->clips.data()};
+  const clip_id* clip{impl->clip.data()};
+  const float* speed{impl->speed.data()};
+  float* time{impl->time.data()};
+  std::uint32_t* frame{impl->frame.data()};
+  std::uint8_t* playing{impl->playing.data()};
+
+  const size_t count{impl->time.size()};
+  for (size_t it{0}; it < count; it++)
+    {
+      const world_impl::clip_data& data{clips[clip[it]]};
+      if (!playing[it] || data.duration <= 0.f) continue;
+
+      time[it] += delta * speed[it];
+      world_impl::seek(data, time[it], frame[it], playing[it]);
+    }
+}
+
+void animation_world::render()
+{
+  const size_t count{impl->time.size()};
+  for (size_t it{0}; it < count; it++)
+    {
+      const animation_clip& clip{impl->clips[impl->clip[it]].clip};
+      if (!clip.texture || !clip.program) continue;
+      renderer::submit(*clip.program, *clip.texture, impl->settings[it],
+                       clip.frames[impl->frame[it]]);
+    }
+}
+
+size_t animation_world::get_count() const { return impl->time.size(); }
+
+animation_world::~animation_world() {}
+
+animation_world::animation_world(animation_world&&) = default;
+animation_world& animation_world::operator=(animation_world&&) = default;
+}  // namespace render
@@ -0,0 +1,114 @@
+#include <render/cached_layer.h>
+#include <render/cached_layer_impl.h>
+#include <render/command_list_impl.h>
+#include "render/renderer.h"
+#include "render/texture2D.h"
+namespace render
+{
+void cached_layer::layer_impl::draw(shader_program& program,
+                                    draw_list* contents,
+                                    const glm::mat4x4& view_projection,
+                                    const sprite_quad::instance& quad,
+                                    blend_mode blend)
+{
+  if (!target)
+    {
+      target = renderer::acquire_target(resolution.x, resolution.y);
+      // without recorded contents a fresh target holds nothing to show
+      if (!target || !contents)
+        {
+          failed = true;
+          return;
+        }
+    }
+  if (contents)
+    {
+      renderer::draw_to_target(*target, view_projection, *contents);
+      // the pass sets its own blend state per run
+      renderer::set_blend_mode(blend);
+    }
+
+  if (!uniforms_resolved)
+    {
+      uniforms_resolved = true;
+      texture = program.get_uniform<int>("s_texture");
+    }
+
+  program.use();
+  program.set(texture, 0);
+  texture2D::active_texture(0);
+  renderer::bind_texture(target->get_color_texture());
+  renderer::get_quad().draw(program, &quad, 1);
+}
+
+cached_layer::layer_impl::~layer_impl()
+{
+  renderer::release_target(std::move(target));
+}
+
+cached_layer::cached_layer(std::shared_ptr<shader_program> program_,
+                           const render_settings& settings_,
+                           const glm::ivec2& resolution)
+    : program{program_}, settings{settings_}
+{
+  impl = std::make_unique<layer_impl>();
+  impl->resolution = glm::max(resolution, glm::ivec2{1});
+  set_area(settings.position, settings.size);
+}
+
+void cached_layer::set_area(const glm::vec2& position, const glm::vec2& size)
+{
+  impl->camera.set_position(position + size * 0.5f);
+  impl->camera.set_view_size(size);
+  impl->valid = false;
+}
+
+void cached_layer::invalidate() { impl->valid = false; }
+
+bool cached_layer::is_valid() const { return impl->valid; }
+
+void cached_layer::render(const std::function<void(command_list&)>& record)
+{
+  if (!renderer::get_camera().is_visible(settings))
+    {
+      renderer::current_stats().culled_sprites++;
+      return;
+    }
+  renderer::current_stats().drawn_sprites++;
+
+  // the render thread could not redraw the texture, record it again
+  if (impl->failed.exchange(false)) impl->valid = false;
+
+  std::shared_ptr<draw_list> contents{};
+  if (!impl->valid)
+    {
+      impl->valid = true;
+      impl->list.begin(impl->camera);
+      record(impl->list);
+
+      command_list::list_impl& recorded{*impl->list.impl};
+      renderer::current_stats().drawn_sprites += recorded.drawn_sprites;
+      renderer::current_stats().culled_sprites += recorded.culled_sprites;
+      contents = std::make_shared<draw_list>();
+      contents->append(recorded.list);
+    }
+
+  const sprite_quad::instance quad{
+      {settings.position, settings.size},
+      {settings.rotation, static_cast<float>(settings.layer)},
+      {0.f, 0.f, 1.f, 1.f},
+      glm::vec4{1.f}};
+  renderer::submit_command(
+      settings.layer, settings.blend,
+      [impl{impl.get()}, program{program}, contents{std::move(contents)},
+       view_projection{impl->camera.get_view_projection()}, quad,
+       blend{settings.blend}]() {
+        impl->draw(*program, contents.get(), view_projection, quad, blend);
+      });
+}
+
+cached_layer::~cached_layer() {}
+
+cached_layer::cached_layer(cached_layer&&) = default;
+cached_layer& cached_layer::operator=(cached_layer&&) = default;
+}  // namespace render
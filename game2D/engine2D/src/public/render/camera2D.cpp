@@ -0,0 +1,81 @@
+#include <render/camera2D.h>
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+namespace render
+{
+void camera2D::set_position(const glm::vec2& position_)
+{
+  position = position_;
+  dirty = true;
+}
+void camera2D::set_zoom(float zoom_)
+{
+  if (zoom_ <= 0) return;
+  zoom = zoom_;
+  dirty = true;
+}
+void camera2D::set_rotation(float rotation_)
+{
+  rotation = rotation_;
+  dirty = true;
+}
+void camera2D::set_view_size(const glm::vec2& view_size_)
+{
+  if (view_size_.x <= 0 || view_size_.y <= 0) return;
+  view_size = view_size_;
+  dirty = true;
+}
+
+const glm::mat4x4& camera2D::get_view_projection() const
+{
+  if (dirty) update();
+  return view_projection;
+}
+const camera2D::bounds& camera2D::get_bounds() const
+{
+  if (dirty) update();
+  return view_bounds;
+}
+
+bool camera2D::is_visible(const render_settings& settings) const
+{
+  return is_visible(settings.position, settings.size);
+}
+bool camera2D::is_visible(const glm::vec2& position_,
+                          const glm::vec2& size) const
+{
+  if (dirty) update();
+
+  // sprites rotate around their center, so the bounding circle covers any
+  // rotation
+  const glm::vec2 center{position_ + size * 0.5f};
+  const float radius{glm::length(size) * 0.5f};
+
+  return center.x + radius >= view_bounds.min.x &&
+         center.x - radius <= view_bounds.max.x &&
+         center.y + radius >= view_bounds.min.y &&
+         center.y - radius <= view_bounds.max.y;
+}
+
+void camera2D::update() const
+{
+  const glm::vec2 scale{2.f * zoom / view_size};
+
+  view_projection = glm::scale(glm::mat4x4{1}, glm::vec3{scale, 1});
+  view_projection = glm::rotate(view_projection, glm::radians(-rotation),
+                                glm::vec3{0, 0, 1});
+  view_projection =
+      glm::translate(view_projection, glm::vec3{-position, 0});
+
+  const glm::vec2 half{view_size * 0.5f / zoom};
+  const float angle{glm::radians(rotation)};
+  const float cos{std::abs(std::cos(angle))};
+  const float sin{std::abs(std::sin(angle))};
+  const glm::vec2 extent{cos * half.x + sin * half.y,
+                         sin * half.x + cos * half.y};
+  view_bounds = {position - extent, position + extent};
+
+  dirty = false;
+}
+}  // namespace render
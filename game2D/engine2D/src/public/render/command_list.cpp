@@ -0,0 +1,50 @@
+#include <render/command_list.h>
+#include <render/command_list_impl.h>
+#include "render/renderer.h"
+namespace render
+{
+command_list::command_list(unsigned int id_) : id{id_}
+{
+  impl = std::make_unique<list_impl>();
+}
+
+void command_list::begin() { begin(renderer::get_camera()); }
+
+void command_list::begin(const camera2D& camera)
+{
+  impl->list.clear();
+  impl->drawn_sprites = 0;
+  impl->culled_sprites = 0;
+
+  impl->camera = camera;
+  // resolves the cached bounds, so culling only reads the snapshot
+  impl->camera.get_bounds();
+}
+
+void command_list::add(shader_program& program, const texture2D& texture,
+                       const render_settings& settings,
+                       const frame_descriptor& frame)
+{
+  if (!impl->camera.is_visible(settings))
+    {
+      impl->culled_sprites++;
+      return;
+    }
+  impl->drawn_sprites++;
+  impl->list.add_sprite(program, texture, settings, frame);
+}
+
+bool command_list::is_visible(const render_settings& settings) const
+{
+  return impl->camera.is_visible(settings);
+}
+
+void command_list::submit() { renderer::submit_list(*this); }
+
+size_t command_list::get_size() const { return impl->list.size(); }
+
+command_list::~command_list() {}
+
+command_list::command_list(command_list&&) = default;
+command_list& command_list::operator=(command_list&&) = default;
+}  // namespace render
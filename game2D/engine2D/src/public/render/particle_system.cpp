@@ -0,0 +1,315 @@
+#include <render/particle_system.h>
+#include <render/particle_system_impl.h>
+#include <render/simd.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <tuple>
+#include "render/renderer.h"
+#include "render/shader_program.h"
+#include "render/texture2D.h"
+namespace render
+{
+namespace
+{
+// particles of one update part, a multiple of the vector width
+constexpr unsigned int slice_size{8192};
+}  // namespace
+
+void particle_system::system_impl::pool::reserve(unsigned int capacity_)
+{
+  capacity = capacity_;
+  const size_t padded{(static_cast<size_t>(capacity) + 3) & ~size_t{3}};
+  for (std::vector<float>* values :
+       {&x, &y, &velocity_x, &velocity_y, &life, &inverse_lifetime, &size,
+        &red, &green, &blue, &alpha, &frame})
+    values->assign(padded, 0.f);
+}
+
+void particle_system::system_impl::pool::remove(unsigned int index)
+{
+  const unsigned int last{--count};
+  for (std::vector<float>* values :
+       {&x, &y, &velocity_x, &velocity_y, &life, &inverse_lifetime, &size,
+        &red, &green, &blue, &alpha, &frame})
+    (*values)[index] = (*values)[last];
+}
+
+void particle_system::system_impl::spawn(emitter_state& emitter,
+                                         unsigned int count)
+{
+  pool& particles{emitter.particles};
+  const particle_emitter& settings{emitter.settings};
+  const auto next_random = [&emitter]() {
+    std::uint32_t& state{emitter.random};
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return static_cast<float>(state >> 8) * (1.f / 16777216.f);
+  };
+
+  const unsigned int last{std::min(particles.count + count,
+                                   particles.capacity)};
+  for (unsigned int it{particles.count}; it < last; it++)
+    {
+      particles.x[it] =
+          settings.position.x + (next_random() - 0.5f) * settings.area.x;
+      particles.y[it] =
+          settings.position.y + (next_random() - 0.5f) * settings.area.y;
+      particles.velocity_x[it] =
+          settings.velocity_min.x +
+          (settings.velocity_max.x - settings.velocity_min.x) * next_random();
+      particles.velocity_y[it] =
+          settings.velocity_min.y +
+          (settings.velocity_max.y - settings.velocity_min.y) * next_random();
+
+      const float lifetime{
+          settings.lifetime.x +
+          (settings.lifetime.y - settings.lifetime.x) * next_random()};
+      particles.life[it] = lifetime;
+      particles.inverse_lifetime[it] = 1.f / std::max(lifetime, 1e-3f);
+
+      particles.size[it] = settings.size.x;
+      particles.red[it] = settings.color_begin.r;
+      particles.green[it] = settings.color_begin.g;
+      particles.blue[it] = settings.color_begin.b;
+      particles.alpha[it] = settings.color_begin.a;
+      particles.frame[it] = 0.f;
+    }
+  particles.count = last;
+}
+
+void particle_system::system_impl::simulate(emitter_state& emitter,
+                                            unsigned int first,
+                                            unsigned int last, float delta)
+{
+  using namespace simd;
+  pool& particles{emitter.particles};
+  const particle_emitter& settings{emitter.settings};
+
+  const float4 dt{set(delta)};
+  const float4 dvx{set(settings.acceleration.x * delta)};
+  const float4 dvy{set(settings.acceleration.y * delta)};
+  const float4 one{set(1.f)};
+
+  const float4 size_begin{set(settings.size.x)};
+  const float4 size_delta{set(settings.size.y - settings.size.x)};
+  const glm::vec4 color_delta{settings.color_end - settings.color_begin};
+  const float4 red_begin{set(settings.color_begin.r)};
+  const float4 green_begin{set(settings.color_begin.g)};
+  const float4 blue_begin{set(settings.color_begin.b)};
+  const float4 alpha_begin{set(settings.color_begin.a)};
+  const float4 red_delta{set(color_delta.r)};
+  const float4 green_delta{set(color_delta.g)};
+  const float4 blue_delta{set(color_delta.b)};
+  const float4 alpha_delta{set(color_delta.a)};
+  const float4 frames{set(static_cast<float>(settings.frames.size()))};
+
+  for (unsigned int it{first}; it < last; it += 4)
+    {
+      const float4 life{load(&particles.life[it]) - dt};
+      store(&particles.life[it], life);
+
+      const float4 velocity_x{load(&particles.velocity_x[it]) + dvx};
+      const float4 velocity_y{load(&particles.velocity_y[it]) + dvy};
+      store(&particles.velocity_x[it], velocity_x);
+      store(&particles.velocity_y[it], velocity_y);
+      store(&particles.x[it], load(&particles.x[it]) + velocity_x * dt);
+      store(&particles.y[it], load(&particles.y[it]) + velocity_y * dt);
+
+      // 0 at birth, 1 at death
+      const float4 age{one - life * load(&particles.inverse_lifetime[it])};
+      store(&particles.size[it], size_begin + size_delta * age);
+      store(&particles.red[it], red_begin + red_delta * age);
+      store(&particles.green[it], green_begin + green_delta * age);
+      store(&particles.blue[it], blue_begin + blue_delta * age);
+      store(&particles.alpha[it], alpha_begin + alpha_delta * age);
+      store(&particles.frame[it], frames * age);
+    }
+}
+
+particle_system::particle_system(std::shared_ptr<shader_program> program_,
+                                 unsigned int workers)
+    : program{program_}
+{
+  impl = std::make_unique<system_impl>();
+  // a system without a program is only simulated
+  if (program_)
+    impl->texture_uniform = program_->get_uniform<int>("s_texture");
+  if (workers > 0) impl->workers = std::make_unique<worker_pool>(workers);
+}
+
+unsigned int particle_system::add_emitter(const particle_emitter& emitter)
+{
+  if (program && !emitter.texture)
+    std::cerr << "particle_system:: emitter without texture is not rendered"
+              << std::endl;
+
+  system_impl::emitter_state& state{impl->emitters.emplace_back()};
+  state.settings = emitter;
+  if (state.settings.frames.empty())
+    state.settings.frames.push_back(frame_descriptor{});
+  state.particles.reserve(emitter.capacity);
+  // a fixed seed per emitter keeps runs reproducible
+  state.random =
+      0x9e3779b9u * static_cast<std::uint32_t>(impl->emitters.size());
+
+  return static_cast<unsigned int>(impl->emitters.size() - 1);
+}
+
+particle_emitter& particle_system::get_emitter(unsigned int emitter)
+{
+  return impl->emitters[emitter].settings;
+}
+
+void particle_system::burst(unsigned int emitter, unsigned int count)
+{
+  impl->spawn(impl->emitters[emitter], count);
+}
+
+void particle_system::update(double duration)
+{
+  const float delta{static_cast<float>(duration / 1000.0)};
+  if (delta <= 0.f) return;
+
+  impl->slices.clear();
+  for (unsigned int index{0}; index < impl->emitters.size(); index++)
+    {
+      system_impl::emitter_state& emitter{impl->emitters[index]};
+      emitter.spawn_debt += emitter.settings.rate * delta;
+      const float spawned{
+          std::min(std::floor(emitter.spawn_debt),
+                   static_cast<float>(emitter.particles.capacity))};
+      emitter.spawn_debt -= std::floor(emitter.spawn_debt);
+      impl->spawn(emitter, static_cast<unsigned int>(spawned));
+
+      const unsigned int count{(emitter.particles.count + 3) & ~3u};
+      for (unsigned int first{0}; first < count; first += slice_size)
+        impl->slices.push_back(
+            {index, first, std::min(first + slice_size, count)});
+    }
+
+  system_impl& state{*impl};
+  const std::function<void(unsigned int)> task{
+      [&state, delta](unsigned int part) {
+        const system_impl::slice& current{state.slices[part]};
+        system_impl::simulate(state.emitters[current.emitter], current.first,
+                              current.last, delta);
+      }};
+  const unsigned int parts{static_cast<unsigned int>(impl->slices.size())};
+  if (impl->workers)
+    impl->workers->run(parts, task);
+  else
+    for (unsigned int part{0}; part < parts; part++) task(part);
+
+  for (system_impl::emitter_state& emitter : impl->emitters)
+    {
+      system_impl::pool& particles{emitter.particles};
+      for (unsigned int it{0}; it < particles.count;)
+        if (particles.life[it] <= 0.f)
+          particles.remove(it);
+        else
+          it++;
+    }
+}
+
+void particle_system::render()
+{
+  if (!program) return;
+  std::vector<unsigned int>& order{impl->order};
+  order.clear();
+  for (unsigned int index{0}; index < impl->emitters.size(); index++)
+    if (impl->emitters[index].particles.count > 0 &&
+        impl->emitters[index].settings.texture)
+      order.push_back(index);
+
+  // emitters sharing a texture, layer and blend class form one draw
+  const auto group_key = [this](unsigned int index) {
+    const particle_emitter& settings{impl->emitters[index].settings};
+    return std::make_tuple(settings.blend, settings.layer,
+                           settings.texture.get());
+  };
+  std::stable_sort(order.begin(), order.end(),
+                   [&group_key](unsigned int a, unsigned int b) {
+                     return group_key(a) < group_key(b);
+                   });
+
+  for (size_t first{0}; first < order.size();)
+    {
+      const particle_emitter& group{impl->emitters[order[first]].settings};
+      // the storage only grows, so filling it doesn't clear it first
+      size_t used{0};
+
+      size_t last{first};
+      for (; last < order.size() &&
+             group_key(order[last]) == group_key(order[first]);
+           last++)
+        {
+          const system_impl::emitter_state& emitter{
+              impl->emitters[order[last]]};
+          const system_impl::pool& particles{emitter.particles};
+          const std::vector<frame_descriptor>& frames{emitter.settings.frames};
+          const unsigned int last_frame{
+              static_cast<unsigned int>(frames.size() - 1)};
+          const float layer{static_cast<float>(emitter.settings.layer)};
+
+          if (impl->instances.size() < used + particles.count)
+            impl->instances.resize(used + particles.count);
+          sprite_quad::instance* out{impl->instances.data() + used};
+          used += particles.count;
+          for (unsigned int it{0}; it < particles.count; it++, out++)
+            {
+              const float size{particles.size[it]};
+              const frame_descriptor& frame{frames[std::min(
+                  static_cast<unsigned int>(std::max(particles.frame[it], 0.f)),
+                  last_frame)]};
+              out->position_size = {particles.x[it] - size * 0.5f,
+                                    particles.y[it] - size * 0.5f, size, size};
+              out->rotation_layer = {0.f, layer};
+              out->uv = {frame.left_bottom_uv, frame.right_top_uv};
+              out->color = {particles.red[it], particles.green[it],
+                            particles.blue[it], particles.alpha[it]};
+            }
+        }
+
+      renderer::submit_instances(
+          *program, *group.texture, impl->texture_uniform, group.layer,
+          group.blend,
+          impl->instances.data(), static_cast<unsigned int>(used));
+      first = last;
+    }
+}
+
+void particle_system::clear()
+{
+  for (system_impl::emitter_state& emitter : impl->emitters)
+    {
+      emitter.particles.count = 0;
+      emitter.spawn_debt = 0;
+    }
+}
+
+size_t particle_system::get_count() const
+{
+  size_t count{0};
+  for (const system_impl::emitter_state& emitter : impl->emitters)
+    count += emitter.particles.count;
+  return count;
+}
+
+size_t particle_system::get_count(unsigned int emitter) const
+{
+  return impl->emitters[emitter].particles.count;
+}
+
+size_t particle_system::get_emitter_count() const
+{
+  return impl->emitters.size();
+}
+
+particle_system::~particle_system() {}
+
+particle_system::particle_system(particle_system&&) = default;
+particle_system& particle_system::operator=(particle_system&&) = default;
+}  // namespace render
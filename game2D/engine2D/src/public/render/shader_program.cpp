@@ -1,7 +1,9 @@
 #include <glad/glad.h>
+#include <render/renderer.h>
 #include <render/shader_program.h>
 #include <render/sprogram_impl.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <cstring>
 #include <iostream>
 namespace render
 {
@@ -36,7 +38,8 @@ shader_program::shader_program(const std::string& vert_src,
       glGetProgramiv(impl->id, GL_INFO_LOG_LENGTH, &log_length);
       if (log_length != 0)
         {
-          char* info_log{new char[static_cast<unsigned long>(log_length)]};
+          std::string info_log(static_cast<size_t>(log_length), '\0');
+          glGetProgramInfoLog(impl->id, log_length, nullptr, info_log.data());
           std::cerr << "Shader program linker error:" << std::endl
                     << info_log << std::endl;
         }
@@ -44,6 +47,10 @@ shader_program::shader_program(const std::string& vert_src,
   else
     {
       impl->compile_status = true;
+      impl->reflect();
+      if (has_uniform_block(renderer::frame_block_name))
+        bind_uniform_block(renderer::frame_block_name,
+                           renderer::frame_block_binding);
     }
 
   glDeleteShader(v_shader);
@@ -51,30 +58,26 @@ shader_program::shader_program(const std::string& vert_src,
 }
 
 bool shader_program::is_compiled() const { return impl->compile_status; }
-void shader_program::use() const { glUseProgram(impl->id); }
+void shader_program::use() const { renderer::use_program(impl->id); }
 
 shader_program& shader_program::operator=(shader_program&& prg)
 {
-  glDeleteShader(impl->id);
-
-  impl->id = prg.impl->id;
-  impl->compile_status = prg.impl->compile_status;
-
-  prg.impl->id = 0;
-  prg.impl->compile_status = false;
+  // the replaced program is deleted together with prg
+  std::swap(impl, prg.impl);
   return *this;
 }
 
 shader_program::shader_program(shader_program&& prg)
+    : impl{std::make_unique<sprogram_impl>()}
 {
-  impl->id = prg.impl->id;
-  impl->compile_status = prg.impl->compile_status;
-
-  prg.impl->id = 0;
-  prg.impl->compile_status = false;
+  std::swap(impl, prg.impl);
 }
 
-shader_program::~shader_program() { glDeleteShader(impl->id); }
+shader_program::~shader_program()
+{
+  renderer::forget_program(impl->id);
+  glDeleteProgram(impl->id);
+}
 
 bool shader_program::sprogram_impl::create_shader(const std::string& source,
                                                   GLenum s_type,
@@ -95,8 +98,8 @@ bool shader_program::sprogram_impl::create_shader(const std::string& source,
 
       if (log_length != 0)
         {
-          char* info_log{new char[static_cast<unsigned long>(log_length)]};
-          glGetShaderInfoLog(shader_id, log_length, nullptr, info_log);
+          std::string info_log(static_cast<size_t>(log_length), '\0');
+          glGetShaderInfoLog(shader_id, log_length, nullptr, info_log.data());
           std::cerr << "Shader compile time error :" << std::endl
                     << info_log << std::endl;
         }
@@ -105,34 +108,168 @@ bool shader_program::sprogram_impl::create_shader(const std::string& source,
   return true;
 }
 
-bool shader_program::set_uniform(std::string u_name, int value)
+void shader_program::sprogram_impl::reflect()
 {
-  GLint u_id{glGetUniformLocation(impl->id, u_name.c_str())};
+  GLint count{0};
+  GLint max_length{0};
+  std::string name{};
 
-  if (u_id == -1)
+  glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+  name.resize(static_cast<size_t>(max_length));
+  GLint max_location{-1};
+  for (GLuint index{0}; index < static_cast<GLuint>(count); index++)
     {
-      std::cerr << "Can't find uniform: " << u_name << std::endl;
-      return false;
+      GLsizei length{0};
+      GLint size{0};
+      GLenum type{0};
+      glGetActiveUniform(id, index, max_length, &length, &size, &type,
+                         name.data());
+      std::string u_name{name.data(), static_cast<size_t>(length)};
+
+      // uniform block members have no location
+      GLint location{glGetUniformLocation(id, u_name.c_str())};
+      if (location == -1) continue;
+
+      // arrays are reported as "name[0]"
+      const size_t bracket{u_name.find('[')};
+      if (bracket != std::string::npos)
+        uniforms[u_name.substr(0, bracket)] = location;
+      uniforms[u_name] = location;
+
+      if (location > max_location) max_location = location;
     }
+  values.resize(static_cast<size_t>(max_location + 1));
 
-  glUniform1i(u_id, value);
+  glGetProgramiv(id, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+  glGetProgramiv(id, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_length);
+  name.resize(static_cast<size_t>(max_length));
+  for (GLuint index{0}; index < static_cast<GLuint>(count); index++)
+    {
+      GLsizei length{0};
+      glGetActiveUniformBlockName(id, index, max_length, &length, name.data());
+      blocks[std::string{name.data(), static_cast<size_t>(length)}] = index;
+    }
 
-  return true;
+  glGetProgramiv(id, GL_ACTIVE_ATTRIBUTES, &count);
+  glGetProgramiv(id, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_length);
+  name.resize(static_cast<size_t>(max_length));
+  for (GLuint index{0}; index < static_cast<GLuint>(count); index++)
+    {
+      GLsizei length{0};
+      GLint size{0};
+      GLenum type{0};
+      glGetActiveAttrib(id, index, max_length, &length, &size, &type,
+                        name.data());
+      std::string a_name{name.data(), static_cast<size_t>(length)};
+      attributes[a_name] = glGetAttribLocation(id, a_name.c_str());
+    }
 }
 
-bool shader_program::set_uniform(std::string u_name, const glm::mat4x4& value)
+int shader_program::find_uniform(const std::string& u_name) const
 {
-  GLint u_id{glGetUniformLocation(impl->id, u_name.c_str())};
+  auto it{impl->uniforms.find(u_name)};
+  if (it == impl->uniforms.end())
+    {
+      // report every missing uniform only once
+      if (impl->reported.insert(u_name).second)
+        std::cerr << "Can't find uniform: " << u_name << std::endl;
+      return -1;
+    }
+  return it->second;
+}
 
-  if (u_id == -1)
+bool shader_program::bind_uniform_block(const std::string& block_name,
+                                        unsigned int binding)
+{
+  auto it{impl->blocks.find(block_name)};
+  if (it == impl->blocks.end())
     {
-      std::cerr << "Can't find mat4x4-uniform: " << u_name << std::endl;
+      if (impl->reported.insert(block_name).second)
+        std::cerr << "Can't find uniform block: " << block_name << std::endl;
       return false;
     }
+  glUniformBlockBinding(impl->id, it->second, binding);
+  return true;
+}
 
-  glUniformMatrix4fv(u_id, 1, GL_FALSE, glm::value_ptr(value));
+bool shader_program::has_uniform_block(const std::string& block_name) const
+{
+  return impl->blocks.count(block_name) != 0;
+}
+
+int shader_program::get_attribute_location(const std::string& a_name) const
+{
+  auto it{impl->attributes.find(a_name)};
+  return it == impl->attributes.end() ? -1 : it->second;
+}
+
+bool shader_program::upload(int location, const void* value,
+                            unsigned int size)
+{
+  // a location out of the program is ignored like a missing one
+  if (location < 0 || static_cast<size_t>(location) >= impl->values.size())
+    return false;
+  sprogram_impl::uniform_value& cached{
+      impl->values[static_cast<size_t>(location)]};
+  if (cached.assigned && std::memcmp(cached.data.data(), value, size) == 0)
+    return false;
 
+  cached.assigned = true;
+  std::memcpy(cached.data.data(), value, size);
+  use();
   return true;
 }
 
+bool shader_program::set(uniform<int> handle, int value)
+{
+  if (!handle.is_valid() || handle.owner != impl.get()) return false;
+  if (upload(handle.location, &value, sizeof(value)))
+    glUniform1i(handle.location, value);
+  return true;
+}
+
+bool shader_program::set(uniform<float> handle, float value)
+{
+  if (!handle.is_valid() || handle.owner != impl.get()) return false;
+  if (upload(handle.location, &value, sizeof(value)))
+    glUniform1f(handle.location, value);
+  return true;
+}
+
+bool shader_program::set(uniform<glm::vec2> handle, const glm::vec2& value)
+{
+  if (!handle.is_valid() || handle.owner != impl.get()) return false;
+  if (upload(handle.location, glm::value_ptr(value), sizeof(value)))
+    glUniform2fv(handle.location, 1, glm::value_ptr(value));
+  return true;
+}
+
+bool shader_program::set(uniform<glm::vec4> handle, const glm::vec4& value)
+{
+  if (!handle.is_valid() || handle.owner != impl.get()) return false;
+  if (upload(handle.location, glm::value_ptr(value), sizeof(value)))
+    glUniform4fv(handle.location, 1, glm::value_ptr(value));
+  return true;
+}
+
+bool shader_program::set(uniform<glm::mat4x4> handle, const glm::mat4x4& value)
+{
+  if (!handle.is_valid() || handle.owner != impl.get()) return false;
+  if (upload(handle.location, glm::value_ptr(value), sizeof(value)))
+    glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(value));
+  return true;
+}
+
+bool shader_program::set_uniform(const std::string& u_name, int value)
+{
+  return set(get_uniform<int>(u_name), value);
+}
+
+bool shader_program::set_uniform(const std::string& u_name,
+                                 const glm::mat4x4& value)
+{
+  return set(get_uniform<glm::mat4x4>(u_name), value);
+}
+
 }  // namespace render
@@ -1,4 +1,7 @@
 #include "render/sprite_animator.h"
+#include <cmath>
+#include "render/command_list.h"
+#include "render/renderer.h"
 #include "render/sprite2D.h"
 
 namespace render
@@ -12,17 +15,24 @@ void sprite_animator::update(double duration)
 {
   if (frames.size() > 0)
     {
+      // a hold frame is never left, the time stops with it
+      if (frames[current_frame_index].duration < 0) return;
       current_duration += duration;
-      double max_duration{frames[current_frame_index].duration};
-      //  while (current_duration >= max_duration)
-      //    {
-      //      current_duration -= max_duration;
-      //      current_frame_index = (current_frame_index + 1) % frames.size();
-      //      double max_duration = frames[current_frame_index].duration;
-      //    }
-
-      if (current_duration >= max_duration)
+      if (!offscreen_updates && !visible)
+        {
+          // keep the phase without switching frames
+          // a hold frame ahead needs the whole time to be reached later
+          if (loop_duration > 0)
+            current_duration = std::fmod(current_duration, loop_duration);
+          return;
+        }
+      // a long frame may pass several animation frames
+      if (loop_duration > 0 && current_duration >= loop_duration)
+        current_duration = std::fmod(current_duration, loop_duration);
+      for (size_t step{0}; step < frames.size(); step++)
         {
+          const double max_duration{frames[current_frame_index].duration};
+          if (max_duration < 0 || current_duration < max_duration) break;
           current_duration -= max_duration;
           current_frame_index++;
           current_frame_index %= frames.size();
@@ -31,22 +41,39 @@ void sprite_animator::update(double duration)
 }
 void sprite_animator::render(const render_settings& settings)
 {
+  if (!offscreen_updates)
+    visible = renderer::get_camera().is_visible(settings);
   if (frames.size() > 0)
     sprite->render(settings, frames[current_frame_index].discriptor);
   else
     sprite->render(settings);
 }
 
+void sprite_animator::render(command_list& list,
+                             const render_settings& settings)
+{
+  if (!offscreen_updates) visible = list.is_visible(settings);
+  if (frames.size() > 0)
+    sprite->render(list, settings, frames[current_frame_index].discriptor);
+  else
+    sprite->render(list, settings);
+}
+
 void sprite_animator::add_frame(const frame_descriptor& discriptor,
                                 double duration)
 {
   frames.push_back({discriptor, duration});
   summary_duration += duration;
+  if (duration < 0) has_hold_frame = true;
+  // the sequence loops only while no frame holds it
+  loop_duration = has_hold_frame ? 0 : summary_duration;
 }
 void sprite_animator::clear_frames()
 {
   frames.clear();
   summary_duration = 0;
+  loop_duration = 0;
+  has_hold_frame = false;
   current_frame_index = 0;
 }
 
@@ -0,0 +1,55 @@
+#include <render/sprite_instances.h>
+#include <render/sprite_instances_impl.h>
+#include "render/renderer.h"
+#include "render/shader_program.h"
+#include "render/texture2D.h"
+namespace render
+{
+sprite_instances::sprite_instances(std::shared_ptr<texture2D> texture_,
+                                   std::string subtexture_,
+                                   std::shared_ptr<shader_program> program_)
+    : program{program_}, texture{texture_}
+{
+  frame = texture_->get_subtexture(subtexture_);
+  impl = std::make_unique<instances_impl>();
+  impl->texture_uniform = program_->get_uniform<int>("s_texture");
+}
+
+void sprite_instances::add(const render_settings& settings)
+{
+  add(settings, frame);
+}
+
+void sprite_instances::add(const render_settings& settings,
+                           const frame_descriptor& f_discriptor)
+{
+  if (impl->instances.empty() || settings.layer < impl->min_layer)
+    impl->min_layer = settings.layer;
+  impl->instances.push_back(
+      {{settings.position, settings.size},
+       {settings.rotation, static_cast<float>(settings.layer)},
+       {f_discriptor.left_bottom_uv, f_discriptor.right_top_uv},
+       glm::vec4{1.f}});
+}
+
+void sprite_instances::set_blend(blend_mode blend) { impl->blend = blend; }
+
+void sprite_instances::clear() { impl->instances.clear(); }
+
+size_t sprite_instances::get_count() const { return impl->instances.size(); }
+
+void sprite_instances::render()
+{
+  if (impl->instances.empty()) return;
+
+  renderer::submit_instances(*program, *texture, impl->texture_uniform,
+                             impl->min_layer, impl->blend,
+                             impl->instances.data(),
+                             static_cast<unsigned int>(impl->instances.size()));
+}
+
+sprite_instances::~sprite_instances() {}
+
+sprite_instances::sprite_instances(sprite_instances&&) = default;
+sprite_instances& sprite_instances::operator=(sprite_instances&&) = default;
+}  // namespace render
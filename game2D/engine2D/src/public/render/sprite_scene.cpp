@@ -0,0 +1,264 @@
+#include <render/sprite_scene.h>
+#include <render/sprite_scene_impl.h>
+#include <algorithm>
+#include "render/renderer.h"
+#include "render/shader_program.h"
+#include "render/texture2D.h"
+namespace render
+{
+namespace
+{
+// the smallest buffer, so the first sprites don't reallocate it one by one
+constexpr unsigned int min_capacity{256};
+
+sprite_quad::instance to_instance(const render_settings& settings,
+                                  const frame_descriptor& frame,
+                                  const glm::vec4& color)
+{
+  return {{settings.position, settings.size},
+          {settings.rotation, static_cast<float>(settings.layer)},
+          {frame.left_bottom_uv, frame.right_top_uv},
+          color};
+}
+}  // namespace
+
+sprite_scene::scene_impl::gpu_state::gpu_state()
+{
+  vao.bind();
+
+  float quad_pos[]{0, 0, 0, 1, 1, 0, 1, 1};
+  quad_vbo.restore(sizeof(quad_pos), quad_pos);
+
+  vertex_buffer_descriptor quad_descriptor{};
+  quad_descriptor.add_element_descriptor_float(2, false);
+  vao.bind_vertex_buffer(quad_vbo, quad_descriptor);
+
+  vertex_buffer_descriptor instance_descriptor{};
+  instance_descriptor.add_element_descriptor_float(4, false);
+  instance_descriptor.add_element_descriptor_float(2, false);
+  instance_descriptor.add_element_descriptor_float(4, false);
+  instance_descriptor.add_element_descriptor_float(4, false);
+  vao.bind_vertex_buffer(instance_vbo, instance_descriptor, 1);
+
+  unsigned int indices[]{1, 0, 2, 3};
+  vebo.restore(4, indices);
+}
+
+void sprite_scene::scene_impl::mark_dirty(unsigned int index)
+{
+  if (dirty_flags[index]) return;
+  dirty_flags[index] = 1;
+  dirty.push_back(index);
+}
+
+std::vector<sprite_scene::scene_impl::range_upload>
+sprite_scene::scene_impl::collect_uploads()
+{
+  std::vector<range_upload> uploads{};
+  const unsigned int count{static_cast<unsigned int>(instances.size())};
+
+  if (count > capacity)
+    {
+      capacity = std::max({count, capacity * 2, min_capacity});
+      uploads.push_back({0, instances});
+    }
+  else
+    {
+      std::sort(dirty.begin(), dirty.end());
+      for (size_t it{0}; it < dirty.size();)
+        {
+          // slots past the end were removed after they had been changed
+          if (dirty[it] >= count) break;
+
+          const unsigned int first{dirty[it]};
+          unsigned int last{first + 1};
+          for (it++; it < dirty.size() && dirty[it] < count &&
+                     dirty[it] <= last + merge_gap;
+               it++)
+            last = dirty[it] + 1;
+
+          uploads.push_back({first, {instances.begin() + first,
+                                     instances.begin() + last}});
+        }
+    }
+
+  for (unsigned int index : dirty)
+    if (index < count) dirty_flags[index] = 0;
+  dirty.clear();
+  return uploads;
+}
+
+void sprite_scene::scene_impl::draw(shader_program& program, texture2D& atlas,
+                                    unsigned int count,
+                                    unsigned int capacity_,
+                                    const std::vector<range_upload>& uploads)
+{
+  if (!gpu) gpu = std::make_unique<gpu_state>();
+
+  if (capacity_ > gpu->capacity)
+    {
+      gpu->instance_vbo.restore(
+          capacity_ * static_cast<unsigned int>(sizeof(sprite_quad::instance)),
+          nullptr);
+      gpu->capacity = capacity_;
+    }
+  for (const range_upload& upload : uploads)
+    gpu->instance_vbo.update_range(
+        upload.first * static_cast<unsigned int>(sizeof(sprite_quad::instance)),
+        static_cast<unsigned int>(upload.instances.size() *
+                                  sizeof(sprite_quad::instance)),
+        upload.instances.data());
+
+  if (!uniforms_resolved)
+    {
+      uniforms_resolved = true;
+      texture = program.get_uniform<int>("s_texture");
+    }
+
+  program.use();
+  program.set(texture, 0);
+  texture2D::active_texture(0);
+  atlas.bind();
+
+  renderer::draw_instanced(gpu->vao, gpu->vebo, program, count,
+                           GL_TRIANGLE_FAN);
+}
+
+sprite_scene::sprite_scene(std::shared_ptr<texture2D> texture_,
+                           std::shared_ptr<shader_program> program_)
+    : program{program_}, texture{texture_}
+{
+  impl = std::make_unique<scene_impl>();
+}
+
+sprite_scene::handle sprite_scene::create(const render_settings& settings,
+                                          const frame_descriptor& frame,
+                                          const glm::vec4& color)
+{
+  handle sprite{0};
+  if (!impl->free_handles.empty())
+    {
+      sprite = impl->free_handles.back();
+      impl->free_handles.pop_back();
+    }
+  else
+    {
+      sprite = static_cast<handle>(impl->dense_index.size());
+      impl->dense_index.push_back(scene_impl::no_sprite);
+    }
+
+  if (impl->instances.empty() || settings.layer < impl->min_layer)
+    impl->min_layer = settings.layer;
+
+  const unsigned int index{static_cast<unsigned int>(impl->instances.size())};
+  impl->dense_index[sprite] = index;
+  impl->instances.push_back(to_instance(settings, frame, color));
+  impl->settings.push_back(settings);
+  impl->owner.push_back(sprite);
+  impl->dirty_flags.push_back(0);
+  impl->mark_dirty(index);
+  return sprite;
+}
+
+void sprite_scene::destroy(handle sprite)
+{
+  const unsigned int index{impl->index_of(sprite)};
+  const unsigned int last{
+      static_cast<unsigned int>(impl->instances.size() - 1)};
+
+  // the last sprite takes the place of the removed one
+  if (index != last)
+    {
+      impl->instances[index] = impl->instances[last];
+      impl->settings[index] = impl->settings[last];
+      impl->owner[index] = impl->owner[last];
+      impl->dense_index[impl->owner[index]] = index;
+      impl->mark_dirty(index);
+    }
+
+  impl->instances.pop_back();
+  impl->settings.pop_back();
+  impl->owner.pop_back();
+  impl->dirty_flags.pop_back();
+  impl->dense_index[sprite] = scene_impl::no_sprite;
+  impl->free_handles.push_back(sprite);
+}
+
+void sprite_scene::set_settings(handle sprite, const render_settings& settings)
+{
+  const unsigned int index{impl->index_of(sprite)};
+  sprite_quad::instance& current{impl->instances[index]};
+  current.position_size = {settings.position, settings.size};
+  current.rotation_layer = {settings.rotation,
+                            static_cast<float>(settings.layer)};
+  impl->settings[index] = settings;
+  impl->min_layer = std::min(impl->min_layer, settings.layer);
+  impl->mark_dirty(index);
+}
+
+void sprite_scene::set_position(handle sprite, const glm::vec2& position)
+{
+  const unsigned int index{impl->index_of(sprite)};
+  impl->instances[index].position_size.x = position.x;
+  impl->instances[index].position_size.y = position.y;
+  impl->settings[index].position = position;
+  impl->mark_dirty(index);
+}
+
+void sprite_scene::set_frame(handle sprite, const frame_descriptor& frame)
+{
+  const unsigned int index{impl->index_of(sprite)};
+  impl->instances[index].uv = {frame.left_bottom_uv, frame.right_top_uv};
+  impl->mark_dirty(index);
+}
+
+void sprite_scene::set_color(handle sprite, const glm::vec4& color)
+{
+  const unsigned int index{impl->index_of(sprite)};
+  impl->instances[index].color = color;
+  impl->mark_dirty(index);
+}
+
+const render_settings& sprite_scene::get_settings(handle sprite) const
+{
+  return impl->settings[impl->index_of(sprite)];
+}
+
+void sprite_scene::set_blend(blend_mode blend) { impl->blend = blend; }
+
+void sprite_scene::clear()
+{
+  impl->instances.clear();
+  impl->settings.clear();
+  impl->owner.clear();
+  impl->dirty_flags.clear();
+  impl->dense_index.clear();
+  impl->free_handles.clear();
+  impl->dirty.clear();
+}
+
+size_t sprite_scene::get_count() const { return impl->instances.size(); }
+
+size_t sprite_scene::get_dirty_count() const { return impl->dirty.size(); }
+
+void sprite_scene::render()
+{
+  const unsigned int count{static_cast<unsigned int>(impl->instances.size())};
+  if (count == 0) return;
+  renderer::current_stats().drawn_sprites += count;
+
+  // collecting may grow the capacity, so it goes first
+  std::vector<scene_impl::range_upload> uploads{impl->collect_uploads()};
+  renderer::submit_command(
+      impl->min_layer, impl->blend,
+      [impl{impl.get()}, program{program}, texture{texture}, count,
+       capacity{impl->capacity}, uploads{std::move(uploads)}]() {
+        impl->draw(*program, *texture, count, capacity, uploads);
+      });
+}
+
+sprite_scene::~sprite_scene() {}
+
+sprite_scene::sprite_scene(sprite_scene&&) = default;
+sprite_scene& sprite_scene::operator=(sprite_scene&&) = default;
+}  // namespace render
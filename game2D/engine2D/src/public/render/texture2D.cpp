@@ -1,28 +1,75 @@
 #include "render/texture2D.h"
 #include <glad/glad.h>
+#include <render/renderer.h>
+#include <algorithm>
 #include <hash_set>
 #include <iostream>
 namespace render
 {
-GLenum get_gl_color(color_format format)
+namespace
+{
+/*!
+ * \brief Описание формата для загрузки в gl-текстуру
+ */
+struct gl_texture_format
+{
+  GLint internal;
+  GLenum format;  ///< формат данных, не используется для сжатых форматов
+  GLenum type;    ///< тип данных, не используется для сжатых форматов
+  unsigned int block_size;  ///< байт на блок 4x4 для сжатых форматов
+};
+
+gl_texture_format get_gl_format(color_format format)
 {
   switch (format)
     {
       case color_format::red:
-        return GL_RED;
+        return {GL_RED, GL_RED, GL_UNSIGNED_BYTE, 0};
       case color_format::green:
-        return GL_GREEN;
+        return {GL_GREEN, GL_GREEN, GL_UNSIGNED_BYTE, 0};
       case color_format::blue:
-        return GL_BLUE;
+        return {GL_BLUE, GL_BLUE, GL_UNSIGNED_BYTE, 0};
       case color_format::alpha:
-        return GL_ALPHA;
+        return {GL_ALPHA, GL_ALPHA, GL_UNSIGNED_BYTE, 0};
       case color_format::rgb:
-        return GL_RGB;
+        return {GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, 0};
       case color_format::rgba:
-        return GL_RGBA;
+        return {GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE, 0};
+      case color_format::rgb565:
+        return {GL_RGB565, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, 0};
+      case color_format::rgba4444:
+        return {GL_RGBA4, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, 0};
+      case color_format::etc2_rgb:
+        return {GL_COMPRESSED_RGB8_ETC2, GL_NONE, GL_NONE, 8};
+      case color_format::etc2_rgb_a1:
+        return {GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2, GL_NONE, GL_NONE,
+                8};
+      case color_format::etc2_rgba:
+        return {GL_COMPRESSED_RGBA8_ETC2_EAC, GL_NONE, GL_NONE, 16};
+      case color_format::eac_r11:
+        return {GL_COMPRESSED_R11_EAC, GL_NONE, GL_NONE, 8};
+      case color_format::eac_rg11:
+        return {GL_COMPRESSED_RG11_EAC, GL_NONE, GL_NONE, 16};
+    }
+  return {GL_NONE, GL_NONE, GL_NONE, 0};
+}
+
+unsigned int get_texel_size(color_format format)
+{
+  switch (format)
+    {
+      case color_format::rgb:
+        return 3;
+      case color_format::rgba:
+        return 4;
+      case color_format::rgb565:
+      case color_format::rgba4444:
+        return 2;
+      default:
+        return 1;
     }
-  return GL_NONE;
 }
+}  // namespace
 
 GLint get_gl_filter(texture_filter filter)
 {
@@ -54,14 +101,48 @@ texture2D::texture2D(int width_, int height_, const void* data,
                      const color_format format, const texture_filter filter,
                      const wrap_mode w_mode)
     : height{height_}, width{width_}
+{
+  upload({{width, height, data, get_image_size(width, height, format)}},
+         format, filter, w_mode);
+}
+
+texture2D::texture2D(const std::vector<level>& levels,
+                     const color_format format, const texture_filter filter,
+                     const wrap_mode w_mode, bool generate_mipmaps)
+{
+  if (!levels.empty())
+    {
+      width = levels.front().width;
+      height = levels.front().height;
+    }
+  upload(levels, format, filter, w_mode, generate_mipmaps);
+}
+
+void texture2D::upload(const std::vector<level>& levels, color_format format,
+                       texture_filter filter, wrap_mode w_mode,
+                       bool generate_mipmaps)
 {
   glGenTextures(1, &id);
-  glBindTexture(GL_TEXTURE_2D, id);
+  renderer::bind_texture(id);
 
-  GLenum gl_color{get_gl_color(format)};
+  // rows of rgb and 16-bit textures are not aligned to 4 bytes
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-  glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(gl_color), width, height, 0,
-               gl_color, GL_UNSIGNED_BYTE, data);
+  const gl_texture_format gl_format{get_gl_format(format)};
+  for (size_t it{0}; it < levels.size(); it++)
+    {
+      const level& current{levels[it]};
+      if (is_compressed(format))
+        glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(it),
+                               static_cast<GLenum>(gl_format.internal),
+                               current.width, current.height, 0,
+                               static_cast<GLsizei>(current.size),
+                               current.data);
+      else
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(it), gl_format.internal,
+                     current.width, current.height, 0, gl_format.format,
+                     gl_format.type, current.data);
+    }
 
   GLint gl_wrap_mode{get_gl_wrap_mode(w_mode)};
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, gl_wrap_mode);
@@ -71,17 +152,49 @@ texture2D::texture2D(int width_, int height_, const void* data,
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_filter);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_filter);
 
-  glGenerateMipmap(GL_TEXTURE_2D);
+  if (levels.size() > 1)
+    {
+      // the loaded chain is used as is
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+                      static_cast<GLint>(levels.size() - 1));
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                      gl_filter == GL_LINEAR ? GL_LINEAR_MIPMAP_LINEAR
+                                             : GL_NEAREST_MIPMAP_NEAREST);
+    }
+  else if (!is_compressed(format))
+    {
+      glGenerateMipmap(GL_TEXTURE_2D);
+      if (generate_mipmaps)
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                        gl_filter == GL_LINEAR ? GL_LINEAR_MIPMAP_LINEAR
+                                               : GL_NEAREST_MIPMAP_NEAREST);
+    }
+}
+
+size_t texture2D::get_image_size(int width_, int height_, color_format format)
+{
+  const size_t w{static_cast<size_t>(std::max(width_, 0))};
+  const size_t h{static_cast<size_t>(std::max(height_, 0))};
+  if (is_compressed(format))
+    return ((w + 3) / 4) * ((h + 3) / 4) * get_gl_format(format).block_size;
+  return w * h * get_texel_size(format);
+}
 
-  glBindTexture(GL_TEXTURE_2D, 0);
+bool texture2D::is_compressed(color_format format)
+{
+  return get_gl_format(format).block_size != 0;
 }
 
-void texture2D::bind() const { glBindTexture(GL_TEXTURE_2D, id); }
+void texture2D::bind() const { renderer::bind_texture(id); }
 
 int texture2D::get_width() const { return width; }
 int texture2D::get_height() const { return height; }
 
-texture2D::~texture2D() { glDeleteTextures(1, &id); }
+texture2D::~texture2D()
+{
+  renderer::forget_texture(id);
+  glDeleteTextures(1, &id);
+}
 
 texture2D::texture2D(texture2D&& texture)
 {
@@ -94,6 +207,7 @@ texture2D::texture2D(texture2D&& texture)
 
 texture2D& texture2D::operator=(texture2D&& texture)
 {
+  renderer::forget_texture(id);
   glDeleteTextures(1, &id);
 
   id = texture.id;
@@ -107,8 +221,7 @@ texture2D& texture2D::operator=(texture2D&& texture)
 
 void texture2D::active_texture(unsigned int offset)
 {
-  GLenum buffer{GL_TEXTURE0 + offset};
-  glActiveTexture(buffer);
+  renderer::active_texture(offset);
 }
 
 const frame_descriptor& texture2D::add_subtexture(
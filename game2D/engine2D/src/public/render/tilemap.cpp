@@ -0,0 +1,220 @@
+#include <render/tilemap.h>
+#include <render/tilemap_impl.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <iostream>
+#include "render/renderer.h"
+#include "render/shader_program.h"
+#include "render/texture2D.h"
+namespace render
+{
+tilemap::tilemap(std::shared_ptr<texture2D> texture_,
+                 std::shared_ptr<shader_program> program_,
+                 unsigned int columns_, unsigned int rows_,
+                 const glm::vec2& tile_size_, unsigned int chunk_size_)
+    : columns{columns_},
+      rows{rows_},
+      tile_size{tile_size_},
+      chunk_size{std::max(chunk_size_, 1u)},
+      program{program_},
+      texture{texture_}
+{
+  impl = std::make_unique<tilemap_impl>();
+  impl->chunk_size = chunk_size;
+  impl->tiles.assign(static_cast<size_t>(columns) * rows, empty_tile);
+  impl->chunk_columns = (columns + chunk_size - 1) / chunk_size;
+  impl->chunk_rows = (rows + chunk_size - 1) / chunk_size;
+  impl->chunks.resize(static_cast<size_t>(impl->chunk_columns) *
+                      impl->chunk_rows);
+}
+
+int tilemap::add_tile(const std::string& subtexture)
+{
+  return add_tile(texture->get_subtexture(subtexture));
+}
+
+int tilemap::add_tile(const frame_descriptor& frame)
+{
+  impl->tile_set.push_back(frame);
+  return static_cast<int>(impl->tile_set.size() - 1);
+}
+
+bool tilemap::set_tiles(const std::vector<int>& tiles)
+{
+  if (tiles.size() != impl->tiles.size())
+    {
+      std::cerr << "tilemap: " << tiles.size() << " tiles don't match the "
+                << columns << "x" << rows << " map" << std::endl;
+      return false;
+    }
+  for (size_t it{0}; it < tiles.size(); it++)
+    if (tiles[it] != empty_tile &&
+        (tiles[it] < 0 ||
+         static_cast<size_t>(tiles[it]) >= impl->tile_set.size()))
+      {
+        std::cerr << "tilemap: tile " << tiles[it] << " at " << it
+                  << " is not in the tile set" << std::endl;
+        return false;
+      }
+  impl->tiles = tiles;
+  for (tilemap_impl::chunk& chunk : impl->chunks) chunk.dirty = true;
+  return true;
+}
+
+void tilemap::set_tile(unsigned int column, unsigned int row, int tile)
+{
+  if (column >= columns || row >= rows) return;
+  if (tile != empty_tile &&
+      (tile < 0 || static_cast<size_t>(tile) >= impl->tile_set.size()))
+    return;
+
+  int& current{impl->tiles[static_cast<size_t>(row) * columns + column]};
+  if (current == tile) return;
+  current = tile;
+  impl->chunks[(row / chunk_size) * impl->chunk_columns + column / chunk_size]
+      .dirty = true;
+}
+
+int tilemap::get_tile(unsigned int column, unsigned int row) const
+{
+  if (column >= columns || row >= rows) return empty_tile;
+  return impl->tiles[static_cast<size_t>(row) * columns + column];
+}
+
+void tilemap::render()
+{
+  const camera2D& camera{renderer::get_camera()};
+  const glm::vec2 chunk_extent{tile_size * static_cast<float>(chunk_size)};
+
+  // chunks are rebuilt here, so the command doesn't read the tiles
+  std::vector<tilemap_impl::visible_chunk> visible{};
+  for (unsigned int chunk_row{0}; chunk_row < impl->chunk_rows; chunk_row++)
+    for (unsigned int chunk_column{0}; chunk_column < impl->chunk_columns;
+         chunk_column++)
+      {
+        const glm::vec2 origin{
+            position + chunk_extent * glm::vec2{chunk_column, chunk_row}};
+        if (!camera.is_visible(origin, chunk_extent)) continue;
+
+        const unsigned int chunk{chunk_row * impl->chunk_columns +
+                                 chunk_column};
+        if (impl->chunks[chunk].dirty) build_chunk(chunk);
+        if (impl->chunks[chunk].quads > 0)
+          visible.push_back({chunk, impl->chunks[chunk].quads});
+      }
+  if (visible.empty() && impl->uploads.empty()) return;
+
+  renderer::submit_command(
+      layer, blend,
+      [impl{impl.get()}, program{program}, texture{texture},
+       model{glm::translate(glm::mat4x4{1}, glm::vec3{position, 0.f})},
+       layer{layer}, visible{std::move(visible)},
+       uploads{std::move(impl->uploads)}]() {
+        impl->draw(*program, *texture, model, layer, visible, uploads);
+      });
+  impl->uploads.clear();
+}
+
+void tilemap::build_chunk(unsigned int chunk)
+{
+  tilemap_impl::chunk& current{impl->chunks[chunk]};
+  current.dirty = false;
+
+  const unsigned int first_column{(chunk % impl->chunk_columns) * chunk_size};
+  const unsigned int first_row{(chunk / impl->chunk_columns) * chunk_size};
+  const unsigned int last_column{std::min(first_column + chunk_size, columns)};
+  const unsigned int last_row{std::min(first_row + chunk_size, rows)};
+
+  // empty tiles are skipped, so a chunk holds only visible quads
+  std::vector<sprite_batch::vertex> vertices{};
+  for (unsigned int row{first_row}; row < last_row; row++)
+    for (unsigned int column{first_column}; column < last_column; column++)
+      {
+        const int tile{impl->tiles[static_cast<size_t>(row) * columns + column]};
+        if (tile == empty_tile) continue;
+
+        const frame_descriptor& frame{impl->tile_set[tile]};
+        const glm::vec2 lb{tile_size * glm::vec2{column, row}};
+        const glm::vec2 rt{lb + tile_size};
+        vertices.push_back({lb, frame.left_bottom_uv});
+        vertices.push_back({{lb.x, rt.y},
+                            {frame.left_bottom_uv.x, frame.right_top_uv.y}});
+        vertices.push_back({{rt.x, lb.y},
+                            {frame.right_top_uv.x, frame.left_bottom_uv.y}});
+        vertices.push_back({rt, frame.right_top_uv});
+      }
+  current.quads = static_cast<unsigned int>(vertices.size() / 4);
+  if (current.quads > 0) impl->uploads.push_back({chunk, std::move(vertices)});
+}
+
+void tilemap::tilemap_impl::draw(shader_program& program, texture2D& atlas,
+                                 const glm::mat4x4& model_matrix,
+                                 int map_layer,
+                                 const std::vector<visible_chunk>& visible,
+                                 const std::vector<chunk_upload>& uploads)
+{
+  if (!ibo)
+    {
+      // every chunk uses the same quad order as the sprite batch
+      std::vector<unsigned int> indices(chunk_size * chunk_size * 6);
+      for (unsigned int quad{0}; quad < chunk_size * chunk_size; quad++)
+        {
+          const unsigned int vertex{quad * 4};
+          unsigned int* out{&indices[quad * 6]};
+          out[0] = vertex + 0;
+          out[1] = vertex + 1;
+          out[2] = vertex + 2;
+          out[3] = vertex + 2;
+          out[4] = vertex + 1;
+          out[5] = vertex + 3;
+        }
+      ibo = std::make_unique<index_buffer>(
+          static_cast<unsigned int>(indices.size()), indices.data());
+
+      descriptor.add_element_descriptor_float(2, false);
+      descriptor.add_element_descriptor_float(2, false);
+    }
+
+  for (const chunk_upload& upload : uploads)
+    {
+      std::unique_ptr<chunk_mesh>& mesh{chunks[upload.chunk].mesh};
+      if (!mesh)
+        {
+          mesh = std::make_unique<chunk_mesh>();
+          mesh->vbo.restore(
+              chunk_size * chunk_size * 4 *
+                  static_cast<unsigned int>(sizeof(sprite_batch::vertex)),
+              nullptr);
+          mesh->vao.bind_vertex_buffer(mesh->vbo, descriptor);
+        }
+      mesh->vbo.update(static_cast<unsigned int>(upload.vertices.size() *
+                                                 sizeof(sprite_batch::vertex)),
+                       upload.vertices.data());
+    }
+  if (visible.empty()) return;
+
+  if (!uniforms_resolved)
+    {
+      uniforms_resolved = true;
+      model = program.get_uniform<glm::mat4x4>("s_model");
+      texture = program.get_uniform<int>("s_texture");
+      layer = program.get_uniform<int>("s_layer");
+    }
+
+  program.use();
+  program.set(model, model_matrix);
+  program.set(texture, 0);
+  program.set(layer, map_layer);
+  texture2D::active_texture(0);
+  atlas.bind();
+
+  for (const visible_chunk& current : visible)
+    renderer::draw(chunks[current.chunk].mesh->vao, *ibo, program,
+                   current.quads * 6, 0);
+}
+
+tilemap::~tilemap() {}
+
+tilemap::tilemap(tilemap&&) = default;
+tilemap& tilemap::operator=(tilemap&&) = default;
+}  // namespace render
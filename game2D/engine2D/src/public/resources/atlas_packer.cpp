@@ -0,0 +1,239 @@
+#include "resources/atlas_packer.h"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+namespace resources
+{
+atlas_packer::atlas_packer(unsigned int page_width_, unsigned int page_height_,
+                           unsigned int padding_, unsigned int extrude_)
+    : page_width{page_width_},
+      page_height{page_height_},
+      padding{padding_},
+      extrude{extrude_}
+{
+}
+
+bool atlas_packer::add_image(const std::string& name, unsigned int width,
+                             unsigned int height, unsigned int channels,
+                             const unsigned char* data)
+{
+  if (width == 0 || height == 0 || channels == 0 || channels > 4 || !data)
+    {
+      std::cerr << "atlas_packer: wrong image <" << name << ">" << std::endl;
+      return false;
+    }
+  if (width + 2 * extrude + padding > page_width ||
+      height + 2 * extrude + padding > page_height)
+    {
+      std::cerr << "atlas_packer: image <" << name << "> " << width << "x"
+                << height << " doesn't fit into a " << page_width << "x"
+                << page_height << " page" << std::endl;
+      return false;
+    }
+
+  image result{name, width, height, {}};
+  result.pixels.resize(static_cast<size_t>(width) * height * 4);
+  for (size_t pixel{0}; pixel < static_cast<size_t>(width) * height; pixel++)
+    {
+      const unsigned char* in{data + pixel * channels};
+      unsigned char* out{&result.pixels[pixel * 4]};
+      switch (channels)
+        {
+          case 1:
+            out[0] = out[1] = out[2] = in[0];
+            out[3] = 255;
+            break;
+          case 2:
+            out[0] = out[1] = out[2] = in[0];
+            out[3] = in[1];
+            break;
+          case 3:
+            out[0] = in[0];
+            out[1] = in[1];
+            out[2] = in[2];
+            out[3] = 255;
+            break;
+          default:
+            std::copy(in, in + 4, out);
+            break;
+        }
+    }
+  images.push_back(std::move(result));
+  return true;
+}
+
+bool atlas_packer::find_position(const std::vector<skyline_node>& skyline,
+                                 unsigned int width, unsigned int height,
+                                 size_t& node_index, unsigned int& x,
+                                 unsigned int& y) const
+{
+  bool found{false};
+  unsigned int best_top{page_height + 1};
+
+  for (size_t node{0}; node < skyline.size(); node++)
+    {
+      const unsigned int left{skyline[node].x};
+      // nodes are sorted by x, so the following ones don't fit either
+      if (left + width > page_width) break;
+
+      // the rectangle lies on the highest node under it
+      unsigned int top{0};
+      unsigned int covered{0};
+      for (size_t it{node}; covered < width; it++)
+        {
+          top = std::max(top, skyline[it].y);
+          covered += skyline[it].width;
+        }
+      if (top + height > page_height) continue;
+
+      if (top + height < best_top)
+        {
+          best_top = top + height;
+          node_index = node;
+          x = left;
+          y = top;
+          found = true;
+        }
+    }
+  return found;
+}
+
+void atlas_packer::add_skyline_level(std::vector<skyline_node>& skyline,
+                                     size_t node_index, unsigned int x,
+                                     unsigned int y, unsigned int width,
+                                     unsigned int height) const
+{
+  skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(node_index),
+                 {x, y + height, width});
+
+  // cut the nodes covered by the new level
+  for (size_t it{node_index + 1}; it < skyline.size();)
+    {
+      const skyline_node& previous{skyline[it - 1]};
+      skyline_node& node{skyline[it]};
+      const unsigned int previous_right{previous.x + previous.width};
+      if (node.x >= previous_right) break;
+
+      const unsigned int shrink{previous_right - node.x};
+      if (node.width <= shrink)
+        {
+          skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(it));
+          continue;
+        }
+      node.x += shrink;
+      node.width -= shrink;
+      break;
+    }
+
+  // merge neighbours of the same height
+  for (size_t it{1}; it < skyline.size();)
+    {
+      if (skyline[it - 1].y == skyline[it].y)
+        {
+          skyline[it - 1].width += skyline[it].width;
+          skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(it));
+        }
+      else
+        it++;
+    }
+}
+
+void atlas_packer::copy_image(std::vector<unsigned char>& page,
+                              const image& source, unsigned int x,
+                              unsigned int y) const
+{
+  // the image is surrounded by copies of its edge pixels
+  const int border{static_cast<int>(extrude)};
+  const int width{static_cast<int>(source.width)};
+  const int height{static_cast<int>(source.height)};
+
+  for (int row{-border}; row < height + border; row++)
+    {
+      const int source_row{std::clamp(row, 0, height - 1)};
+      const size_t page_row{y + extrude + row};
+      for (int column{-border}; column < width + border; column++)
+        {
+          const int source_column{std::clamp(column, 0, width - 1)};
+          const size_t page_column{x + extrude + column};
+
+          const unsigned char* in{
+              &source.pixels[(static_cast<size_t>(source_row) * width +
+                              source_column) *
+                             4]};
+          unsigned char* out{&page[(page_row * page_width + page_column) * 4]};
+          std::copy(in, in + 4, out);
+        }
+    }
+}
+
+std::vector<std::shared_ptr<render::texture2D>> atlas_packer::build(
+    render::texture_filter filter)
+{
+  std::vector<std::shared_ptr<render::texture2D>> result{};
+  placements.clear();
+  if (images.empty()) return result;
+
+  // taller images first give denser skylines
+  std::vector<size_t> order(images.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return images[a].height > images[b].height;
+  });
+
+  std::vector<std::vector<skyline_node>> skylines{};
+  std::vector<std::vector<unsigned char>> pages{};
+
+  for (size_t index : order)
+    {
+      const image& current{images[index]};
+      const unsigned int cell_width{current.width + 2 * extrude + padding};
+      const unsigned int cell_height{current.height + 2 * extrude + padding};
+
+      size_t node{0};
+      unsigned int x{0}, y{0};
+      size_t page{0};
+      while (page < skylines.size() &&
+             !find_position(skylines[page], cell_width, cell_height, node, x,
+                            y))
+        page++;
+
+      if (page == skylines.size())
+        {
+          skylines.push_back({{0, 0, page_width}});
+          pages.emplace_back(static_cast<size_t>(page_width) * page_height * 4,
+                             0);
+          find_position(skylines[page], cell_width, cell_height, node, x, y);
+        }
+
+      add_skyline_level(skylines[page], node, x, y, cell_width, cell_height);
+      copy_image(pages[page], current, x, y);
+      placements.push_back({current.name, static_cast<unsigned int>(page),
+                            x + extrude, y + extrude, current.width,
+                            current.height});
+    }
+
+  for (const std::vector<unsigned char>& pixels : pages)
+    result.push_back(std::make_shared<render::texture2D>(
+        static_cast<int>(page_width), static_cast<int>(page_height),
+        pixels.data(), render::color_format::rgba, filter));
+
+  const glm::vec2 page_size{static_cast<float>(page_width),
+                            static_cast<float>(page_height)};
+  for (const placement& item : placements)
+    {
+      const glm::vec2 left_bottom{static_cast<float>(item.x),
+                                  static_cast<float>(item.y)};
+      const glm::vec2 size{static_cast<float>(item.width),
+                           static_cast<float>(item.height)};
+      result[item.page]->add_subtexture(
+          item.name, render::frame_descriptor{left_bottom / page_size,
+                                              (left_bottom + size) /
+                                                  page_size});
+    }
+
+  std::clog << "atlas_packer: " << images.size() << " images packed into "
+            << result.size() << " pages" << std::endl;
+  images.clear();
+  return result;
+}
+}  // namespace resources
@@ -1,4 +1,6 @@
 #include "resources/resource_manager.h"
+#include "resources/atlas_packer.h"
+#include "resources/ktx_loader.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -7,6 +9,53 @@
 #include "resources/stb_image.h"
 namespace resources
 {
+namespace
+{
+/*!
+ * \brief Преобразование rgba-пикселей в 16-битный формат
+ */
+std::vector<unsigned short> pack_pixels(const unsigned char* rgba,
+                                        size_t count,
+                                        render::color_format format)
+{
+  std::vector<unsigned short> result(count);
+  for (size_t pixel{0}; pixel < count; pixel++)
+    {
+      const unsigned char* in{rgba + pixel * 4};
+      if (format == render::color_format::rgb565)
+        result[pixel] = static_cast<unsigned short>(
+            (in[0] >> 3) << 11 | (in[1] >> 2) << 5 | in[2] >> 3);
+      else
+        result[pixel] = static_cast<unsigned short>(
+            (in[0] >> 4) << 12 | (in[1] >> 4) << 8 | (in[2] >> 4) << 4 |
+            in[3] >> 4);
+    }
+  return result;
+}
+
+/*!
+ * \brief Подготовка rgba-пикселей к смешиванию
+ * Черные пиксели (цветовой ключ) становятся прозрачными, цвет остальных
+ * умножается на альфа-канал
+ */
+void premultiply_alpha(unsigned char* rgba, size_t count)
+{
+  for (size_t pixel{0}; pixel < count; pixel++)
+    {
+      unsigned char* out{rgba + pixel * 4};
+      if (out[0] == 0 && out[1] == 0 && out[2] == 0)
+        {
+          out[3] = 0;
+          continue;
+        }
+      if (out[3] == 255) continue;
+      for (int channel{0}; channel < 3; channel++)
+        out[channel] =
+            static_cast<unsigned char>((out[channel] * out[3] + 127) / 255);
+    }
+}
+}  // namespace
+
 resource_manager::resource_manager(const std::string& dir_path)
 {
   path_configure(dir_path);
@@ -87,11 +136,34 @@ std::string resource_manager::get_file_data(const std::string& additional)
 std::shared_ptr<render::texture2D> resource_manager::load_texture2D(
     const std::string& texture_name, const std::string& filepath)
 {
+  return load_texture2D(texture_name, filepath, render::color_format::rgba);
+}
+std::shared_ptr<render::texture2D> resource_manager::load_texture2D(
+    const std::string& texture_name, const std::string& filepath,
+    render::color_format format)
+{
+  int desired_channels{0};
+  switch (format)
+    {
+      case render::color_format::rgb:
+        desired_channels = 3;
+        break;
+      case render::color_format::rgba:
+      case render::color_format::rgb565:
+      case render::color_format::rgba4444:
+        desired_channels = 4;
+        break;
+      default:
+        std::cerr << "Resource manager: can't to convert texture "
+                  << texture_name << " to the requested format" << std::endl;
+        return nullptr;
+    }
+
   int width, height, channels;
   std::string full_path = path + filepath;
   stbi_set_flip_vertically_on_load(true);
-  unsigned char* data =
-      stbi_load(full_path.c_str(), &width, &height, &channels, 0);
+  unsigned char* data = stbi_load(full_path.c_str(), &width, &height,
+                                  &channels, desired_channels);
   if (data == nullptr)
     {
       std::cerr << "Resource manager: can't to load texture " << texture_name
@@ -99,24 +171,81 @@ std::shared_ptr<render::texture2D> resource_manager::load_texture2D(
                 << "Filepath: " << filepath << std::endl;
       return nullptr;
     }
-  render::color_format format;
-  switch (channels)
+
+  if (desired_channels == 4 && format != render::color_format::rgb565)
+    premultiply_alpha(
+        data, static_cast<size_t>(width) * static_cast<size_t>(height));
+
+  if (format == render::color_format::rgb565 ||
+      format == render::color_format::rgba4444)
     {
-      case 3:
-        format = render::color_format::rgb;
-        break;
-      case 4:
-        format = render::color_format::rgba;
-        break;
-      default:
-        format = render::color_format::rgba;
-        break;
+      const std::vector<unsigned short> packed{pack_pixels(
+          data, static_cast<size_t>(width) * static_cast<size_t>(height),
+          format)};
+      texture_map[texture_name] = std::make_shared<render::texture2D>(
+          width, height, packed.data(), format);
     }
-  texture_map[texture_name] =
-      std::make_shared<render::texture2D>(width, height, data, format);
+  else
+    texture_map[texture_name] =
+        std::make_shared<render::texture2D>(width, height, data, format);
   stbi_image_free(data);
   return texture_map[texture_name];
 }
+
+std::shared_ptr<render::texture2D> resource_manager::load_ktx(
+    const std::string& texture_name, const std::string& filepath,
+    render::texture_filter filter)
+{
+  const std::string file_data{get_file_data(filepath)};
+  ktx_loader::image image{};
+  if (file_data.empty() || !ktx_loader::parse(file_data, image))
+    {
+      std::cerr << "Resource manager: can't to load texture " << texture_name
+                << std::endl
+                << "Filepath: " << filepath << std::endl;
+      return nullptr;
+    }
+
+  // the engine expects the bottom row first
+  std::vector<std::vector<unsigned char>> flipped{};
+  if (!image.bottom_up)
+    {
+      if (render::texture2D::is_compressed(image.format))
+        std::clog << "Resource manager: compressed texture " << texture_name
+                  << " is stored top-down and is loaded unflipped, its "
+                     "texture coordinates must be flipped vertically"
+                  << std::endl;
+      else
+        for (render::texture2D::level& level : image.levels)
+          {
+            const size_t row{render::texture2D::get_image_size(
+                level.width, 1, image.format)};
+            const unsigned char* source{
+                static_cast<const unsigned char*>(level.data)};
+            std::vector<unsigned char>& target{flipped.emplace_back(
+                row * static_cast<size_t>(level.height))};
+            for (int line{0}; line < level.height; line++)
+              std::copy(source + row * static_cast<size_t>(line),
+                        source + row * static_cast<size_t>(line + 1),
+                        target.data() +
+                            row * static_cast<size_t>(level.height - 1 - line));
+            level.data = target.data();
+            level.size = target.size();
+          }
+    }
+
+  // GLES can't build mipmaps of compressed formats
+  if (image.generate_mipmaps && render::texture2D::is_compressed(image.format))
+    std::clog << "Resource manager: mipmaps of compressed texture "
+              << texture_name << " can't be generated, only the first level "
+              << "is used" << std::endl;
+
+  texture_map[texture_name] = std::make_shared<render::texture2D>(
+      image.levels, image.format, filter, render::wrap_mode::clamp_to_edge,
+      image.generate_mipmaps);
+  return texture_map[texture_name];
+}
+
 std::shared_ptr<render::texture2D> resource_manager::get_texture2D(
     const std::string& texture_name)
 {
@@ -220,10 +349,53 @@ std::shared_ptr<render::texture2D> resource_manager::load_texture_atlas2D(
   return texture;
 }
 
+std::vector<std::shared_ptr<render::texture2D>>
+resource_manager::load_packed_atlas(
+    const std::string& atlas_name,
+    const std::vector<std::pair<std::string, std::string>>& images,
+    unsigned int page_size)
+{
+  atlas_packer packer{page_size, page_size};
+  stbi_set_flip_vertically_on_load(true);
+  for (const auto& [image_name, filepath] : images)
+    {
+      int width, height, channels;
+      std::string full_path = path + filepath;
+      unsigned char* data =
+          stbi_load(full_path.c_str(), &width, &height, &channels, 4);
+      if (data == nullptr)
+        {
+          std::cerr << "Resource manager: can't to load image " << image_name
+                    << std::endl
+                    << "Filepath: " << filepath << std::endl;
+          continue;
+        }
+      premultiply_alpha(
+          data, static_cast<size_t>(width) * static_cast<size_t>(height));
+      packer.add_image(image_name, static_cast<unsigned int>(width),
+                       static_cast<unsigned int>(height), 4, data);
+      stbi_image_free(data);
+    }
+
+  std::vector<std::shared_ptr<render::texture2D>> pages{packer.build()};
+  for (size_t page{0}; page < pages.size(); page++)
+    texture_map[atlas_name + "_" + std::to_string(page)] = pages[page];
+  for (const atlas_packer::placement& item : packer.get_placements())
+    packed_image_map[item.name] = atlas_name + "_" + std::to_string(item.page);
+
+  return pages;
+}
+
 std::shared_ptr<render::sprite2D> resource_manager::load_sprite(
     const std::string& sprite_name, const std::string& texture_name,
     const std::string& program_name, const std::string& subtexture_name)
 {
+  auto packed{packed_image_map.find(texture_name)};
+  if (packed != packed_image_map.end() && subtexture_name.empty() &&
+      texture_map.count(texture_name) == 0)
+    return load_sprite(sprite_name, packed->second, program_name,
+                       texture_name);
+
   auto texture{get_texture2D(texture_name)};
   auto program{get_shader_program(program_name)};
   if (!texture || !program)
@@ -2,11 +2,14 @@
 #include <core/window.h>
 #include <glm/vec2.hpp>
 #include <iostream>
+#include <memory>
 #include "core/engine.h"
 #include "core/igame.h"
 #include "glm/vec2.hpp"
 #include "input/input_event.h"
 #include "input/input_manager.h"
+#include "render/cached_layer.h"
+#include "render/command_list.h"
 #include "render/shader_program.h"
 #include "render/sprite2D.h"
 #include "render/sprite_animator.h"
@@ -35,6 +38,13 @@ class game : public core::igame
     auto s_tank{mgr.load_sprite("sprite", "texture", "test_prg", "test1")};
     auto s_map{mgr.load_sprite("tank_map", "tank_map", "test_prg")};
 
+    // the map never changes, so it is drawn into a texture once
+    auto layer_prg{mgr.load_shader_program("layer_prg",
+                                           "shaders/instanced_shader.vert",
+                                           "shaders/particle_shader.frag")};
+    map_layer = std::make_unique<render::cached_layer>(
+        layer_prg, map_settings, glm::ivec2{640, 480});
+
     animator = render::sprite_animator{s_tank};
 
     animator.add_frame(tank_tex->get_subtexture("test1"), 400);
@@ -131,7 +141,9 @@ class game : public core::igame
   void render_output() override
   {
     animator.render(tank_settings);
-    mgr.get_sprite("tank_map")->render(map_settings);
+    map_layer->render([this](render::command_list& list) {
+      mgr.get_sprite("tank_map")->render(list, map_settings);
+    });
   }
 
   bool is_playing() override { return playing; }
@@ -142,9 +154,11 @@ class game : public core::igame
  private:
   render::sprite_animator animator{nullptr};
   render::render_settings tank_settings{};
+  std::unique_ptr<render::cached_layer> map_layer{};
 
-  const render::render_settings map_settings{glm::vec2{-1, -1},
-                                             glm::vec2{2, 2}};
+  // opaque and behind the tank, drawn before the translucent sprites
+  const render::render_settings map_settings{
+      glm::vec2{-1, -1}, glm::vec2{2, 2}, -1, 0.f, render::blend_mode::opaque};
 
   resources::resource_manager mgr{"res/"};
   bool playing{true};
@@ -0,0 +1,19 @@
+#version 300 es
+precision mediump float;
+precision mediump int;
+
+in vec2 v_norm;
+
+uniform sampler2D s_texture;
+
+
+layout(location = 0) out vec4 o_frag_color;
+
+// for sprites drawn with blend_mode::alpha_test only: discard disables
+// early depth rejection, so other sprites use test_shader.frag
+void main()
+{
+    o_frag_color = texture2D(s_texture, v_norm);
+    if(o_frag_color.a < 0.5)
+	discard;
+}
@@ -0,0 +1,54 @@
+#version 300 es
+precision highp float;
+precision highp int;
+
+layout(location = 0) in vec2 sprite_position;
+layout(location = 1) in vec4 i_position_size;
+layout(location = 2) in vec2 i_rotation_layer;
+layout(location = 3) in vec2 i_clip_start;  // x - clip, y - start time in seconds
+
+layout(std140) uniform frame_data
+{
+    mat4 view_projection;
+    vec4 time;      // x - seconds since launch, y - frame duration
+    vec4 viewport;  // xy - size in pixels, zw - 1 / size
+} frame;
+
+// clip headers: first frame texel, frame count, duration, hold flag;
+// then two texels per frame: texture area and frame end time
+uniform highp sampler2D s_animation_table;
+
+out vec2 v_norm;
+out vec4 v_color;
+
+vec4 table_texel(int index)
+{
+    return texelFetch(s_animation_table, ivec2(index % 256, index / 256), 0);
+}
+
+void main()
+{
+    vec4 header = table_texel(int(i_clip_start.x));
+    int first = int(header.x);
+    int count = int(header.y);
+
+    float elapsed = max(frame.time.x - i_clip_start.y, 0.0);
+    float t = header.w > 0.5 || header.z <= 0.0 ? elapsed : mod(elapsed, header.z);
+    int current = 0;
+    while (current < count - 1 && t >= table_texel(first + current * 2 + 1).x)
+        current++;
+
+    vec4 uv = table_texel(first + current * 2);
+    v_norm = mix(uv.xy, uv.zw, sprite_position);
+    v_color = vec4(1.0);
+
+    vec2 half_size = i_position_size.zw * 0.5;
+    float angle = radians(i_rotation_layer.x);
+    float c = cos(angle);
+    float s = sin(angle);
+    vec2 local = (sprite_position - 0.5) * i_position_size.zw;
+    vec2 world = vec2(c * local.x - s * local.y, s * local.x + c * local.y) +
+                 i_position_size.xy + half_size;
+
+    gl_Position = frame.view_projection * vec4(world, i_rotation_layer.y / -50.0, 1);
+}
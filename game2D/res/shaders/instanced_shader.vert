@@ -0,0 +1,34 @@
+#version 300 es
+precision mediump float;
+
+layout(location = 0) in vec2 sprite_position;
+layout(location = 1) in vec4 i_position_size;
+layout(location = 2) in vec2 i_rotation_layer;
+layout(location = 3) in vec4 i_uv;
+layout(location = 4) in vec4 i_color;
+
+layout(std140) uniform frame_data
+{
+    mat4 view_projection;
+    vec4 time;      // x - seconds since launch, y - frame duration
+    vec4 viewport;  // xy - size in pixels, zw - 1 / size
+} frame;
+
+out vec2 v_norm;
+out vec4 v_color;
+
+void main()
+{
+    v_norm = mix(i_uv.xy, i_uv.zw, sprite_position);
+    v_color = i_color;
+
+    vec2 half_size = i_position_size.zw * 0.5;
+    float angle = radians(i_rotation_layer.x);
+    float c = cos(angle);
+    float s = sin(angle);
+    vec2 local = (sprite_position - 0.5) * i_position_size.zw;
+    vec2 world = vec2(c * local.x - s * local.y, s * local.x + c * local.y) +
+                 i_position_size.xy + half_size;
+
+    gl_Position = frame.view_projection * vec4(world, i_rotation_layer.y / -50.0, 1);
+}
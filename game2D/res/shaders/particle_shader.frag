@@ -0,0 +1,17 @@
+#version 300 es
+precision mediump float;
+precision mediump int;
+
+in vec2 v_norm;
+in vec4 v_color;
+
+uniform sampler2D s_texture;
+
+
+layout(location = 0) out vec4 o_frag_color;
+
+void main()
+{
+    // the texture is premultiplied, so the instance color is premultiplied too
+    o_frag_color = texture2D(s_texture, v_norm) * vec4(v_color.rgb * v_color.a, v_color.a);
+}
@@ -0,0 +1,21 @@
+#version 300 es
+precision mediump float;
+
+in vec2 v_norm;
+
+uniform sampler2D s_texture;
+uniform vec2 s_texel;
+uniform vec4 s_parameters;  // xy - blur direction in texels
+
+layout(location = 0) out vec4 o_frag_color;
+
+void main()
+{
+    // 9-tap gaussian folded into 5 bilinear taps
+    vec2 direction = s_texel * s_parameters.xy;
+    vec2 inner = direction * 1.3846153846;
+    vec2 outer = direction * 3.2307692308;
+    o_frag_color = texture(s_texture, v_norm) * 0.2270270270 +
+                   (texture(s_texture, v_norm + inner) + texture(s_texture, v_norm - inner)) * 0.3162162162 +
+                   (texture(s_texture, v_norm + outer) + texture(s_texture, v_norm - outer)) * 0.0702702703;
+}
@@ -0,0 +1,21 @@
+#version 300 es
+precision mediump float;
+
+in vec2 v_norm;
+
+uniform sampler2D s_texture;
+uniform vec2 s_texel;
+uniform vec4 s_parameters;  // x - brightness threshold, y - soft knee width
+
+layout(location = 0) out vec4 o_frag_color;
+
+void main()
+{
+    // four bilinear taps average a 4x4 block when the target is downscaled
+    vec4 color = (texture(s_texture, v_norm + s_texel * vec2(-0.5, -0.5)) +
+                  texture(s_texture, v_norm + s_texel * vec2(0.5, -0.5)) +
+                  texture(s_texture, v_norm + s_texel * vec2(-0.5, 0.5)) +
+                  texture(s_texture, v_norm + s_texel * vec2(0.5, 0.5))) * 0.25;
+    float brightness = max(color.r, max(color.g, color.b));
+    o_frag_color = color * smoothstep(s_parameters.x, s_parameters.x + s_parameters.y, brightness);
+}
@@ -0,0 +1,21 @@
+#version 300 es
+precision mediump float;
+
+in vec2 v_norm;
+
+uniform sampler2D s_texture;  // blurred bright parts, may be downscaled
+uniform sampler2D s_scene;
+uniform vec2 s_texel;
+uniform vec4 s_parameters;  // x - bloom intensity
+
+layout(location = 0) out vec4 o_frag_color;
+
+void main()
+{
+    // tent filter hides the blocks of a downscaled bloom
+    vec4 bloom = (texture(s_texture, v_norm + s_texel * vec2(-0.5, -0.5)) +
+                  texture(s_texture, v_norm + s_texel * vec2(0.5, -0.5)) +
+                  texture(s_texture, v_norm + s_texel * vec2(-0.5, 0.5)) +
+                  texture(s_texture, v_norm + s_texel * vec2(0.5, 0.5))) * 0.25;
+    o_frag_color = texture(s_scene, v_norm) + bloom * s_parameters.x;
+}
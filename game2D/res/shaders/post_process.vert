@@ -0,0 +1,12 @@
+#version 300 es
+precision mediump float;
+
+layout(location = 0) in vec2 quad_position;
+
+out vec2 v_norm;
+
+void main()
+{
+    v_norm = quad_position;
+    gl_Position = vec4(quad_position * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -11,7 +11,6 @@ layout(location = 0) out vec4 o_frag_color;
 
 void main()
 {
+    // textures hold premultiplied color, transparency comes from blending
     o_frag_color = texture2D(s_texture, v_norm);
-    if(o_frag_color.rgb == vec3(0.0,0.0,0.0))
-	discard;
 }
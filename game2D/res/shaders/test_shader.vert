@@ -7,10 +7,17 @@ layout(location = 1) in vec2 tex_coord;
 uniform mat4x4 s_model;
 uniform int s_layer;
 
+layout(std140) uniform frame_data
+{
+    mat4 view_projection;
+    vec4 time;      // x - seconds since launch, y - frame duration
+    vec4 viewport;  // xy - size in pixels, zw - 1 / size
+} frame;
+
 out vec2 v_norm;
 
 void main()
 {
     v_norm = tex_coord;
-    gl_Position = s_model * vec4(sprite_position, float(s_layer) / -50.0, 1);
+    gl_Position = frame.view_projection * s_model * vec4(sprite_position, float(s_layer) / -50.0, 1);
 }